@@ -0,0 +1,319 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Sums up the telemetry log that the game leaves behind.
+ *
+ * The whole log is `mmap()`ed and each column of each block is scanned
+ * straight out of the mapping. The integer columns (the tick, fuel and input
+ * totals, and the counts of each end type) are summed with loops simple
+ * enough for the compiler to vectorise at `-O3`. The touchdown momentum isn't:
+ * it's a float sum, and without `-ffast-math` the compiler has to add it up
+ * strictly in order, so that loop stays scalar. Any damaged stretches of the
+ * log are skipped over, so long as there are whole blocks after them. Build
+ * and run with:
+ *
+ *    gcc -std=gnu99 -O3 analyser.c -o analyser
+ *    ./analyser [log]
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "telemetry.h"
+
+// The running totals for the whole log.
+typedef struct _summary_struct {
+   uint64_t games, blocks;
+   uint64_t skippedBytes, damagedPlaces;
+   uint64_t crashes, landings, quits;
+   uint64_t ticks, fuelUsed;
+   uint64_t inputs[TELEMETRY_INPUTS];
+   double landingXMomentum, landingYMomentum;
+   float minLandingYMomentum, maxLandingYMomentum;
+}SUMMARY;
+
+/**
+ * Adds up one `uint32_t` column.
+ *
+ * @param column the column in question
+ * @param n how many values are in it
+ * @return the total
+ */
+static uint64_t sumColumn(const uint32_t* restrict column, uint32_t n) {
+   uint64_t total = 0;
+   for (uint32_t i = 0; i < n; i++) total += column[i];
+   return total;
+}
+
+/**
+ * Counts how many of the games in a block ended a particular way.
+ *
+ * @param endType the `endType` column
+ * @param n how many values are in it
+ * @param type the end type in question
+ * @return the count
+ */
+static uint64_t countEnds(const uint8_t* restrict endType, uint32_t n,
+                          uint8_t type) {
+   uint64_t total = 0;
+   for (uint32_t i = 0; i < n; i++) total += (endType[i] == type);
+   return total;
+}
+
+/**
+ * Adds one block onto the summary.
+ *
+ * @param summary the summary in question
+ * @param block the start of the block's columns (just past the header)
+ * @param n how many games are in the block
+ */
+static void scanBlock(SUMMARY* summary, const unsigned char* block,
+                      uint32_t n) {
+   // Finds each of the columns; see `telemetry.h` for the order.
+   const unsigned char* p = block;
+   p += TELEMETRY_COLUMN(n, sizeof(uint64_t));
+   const uint32_t* ticks = (const uint32_t*)p;
+   p += TELEMETRY_COLUMN(n, sizeof(uint32_t));
+   const uint32_t* fuelUsed = (const uint32_t*)p;
+   p += TELEMETRY_COLUMN(n, sizeof(uint32_t));
+   const float* restrict xMomentum = (const float*)p;
+   p += TELEMETRY_COLUMN(n, sizeof(float));
+   const float* restrict yMomentum = (const float*)p;
+   p += TELEMETRY_COLUMN(n, sizeof(float));
+   const uint32_t* inputs[TELEMETRY_INPUTS];
+   for (int j = 0; j < TELEMETRY_INPUTS; j++) {
+      inputs[j] = (const uint32_t*)p;
+      p += TELEMETRY_COLUMN(n, sizeof(uint32_t));
+   }
+   const uint8_t* restrict endType = p;
+
+   summary->games += n;
+   summary->blocks++;
+   summary->ticks += sumColumn(ticks, n);
+   summary->fuelUsed += sumColumn(fuelUsed, n);
+   for (int j = 0; j < TELEMETRY_INPUTS; j++)
+      summary->inputs[j] += sumColumn(inputs[j], n);
+   summary->crashes += countEnds(endType, n, TELEMETRY_CRASH);
+   summary->landings += countEnds(endType, n, TELEMETRY_LAND);
+   summary->quits += countEnds(endType, n, TELEMETRY_QUIT);
+
+   // The touchdown momentum only means anything for the landings, so the
+   // rest are masked out. This is the one loop that stays scalar (see above).
+   float xTotal = 0.0f, yTotal = 0.0f;
+   float yMin = INFINITY, yMax = -INFINITY;
+   for (uint32_t i = 0; i < n; i++) {
+      bool landed = (endType[i] == TELEMETRY_LAND);
+      xTotal += landed ? fabsf(xMomentum[i]) : 0.0f;
+      yTotal += landed ? yMomentum[i] : 0.0f;
+      float yLow = landed ? yMomentum[i] : INFINITY;
+      float yHigh = landed ? yMomentum[i] : -INFINITY;
+      yMin = (yLow < yMin) ? yLow : yMin;
+      yMax = (yHigh > yMax) ? yHigh : yMax;
+   }
+   summary->landingXMomentum += xTotal;
+   summary->landingYMomentum += yTotal;
+   if (yMin < summary->minLandingYMomentum)
+      summary->minLandingYMomentum = yMin;
+   if (yMax > summary->maxLandingYMomentum)
+      summary->maxLandingYMomentum = yMax;
+}
+
+/**
+ * Checks whether there's a block header at a given point in the log.
+ *
+ * @param mapped the log in question
+ * @param size how big the log is
+ * @param offset where the header ought to be
+ * @param header filled in with the header, if there is one
+ * @return true if there's a header there, false if not
+ */
+static bool isHeader(const unsigned char* mapped, size_t size, size_t offset,
+                     TELEMETRY_HEADER* header) {
+   if ((offset > size) || (size - offset < sizeof(*header))) return false;
+   memcpy(header, mapped + offset, sizeof(*header));
+
+   return (header->magic == TELEMETRY_MAGIC) &&
+          (header->version == TELEMETRY_VERSION) &&
+          (header->inputs == TELEMETRY_INPUTS);
+}
+
+/**
+ * Checks whether there's a whole block at a given point in the log.
+ *
+ * A block whose write came up short can still have a perfectly good header,
+ * and if more blocks were appended after it, it'll look like it fits too. So
+ * a block only counts if it's followed by the end of the log, another header,
+ * or something too short to be either.
+ *
+ * @param mapped the log in question
+ * @param size how big the log is
+ * @param offset where the block ought to start
+ * @param header filled in with the block's header, if there is one
+ * @return true if there's a block there, false if not
+ */
+static bool isBlock(const unsigned char* mapped, size_t size, size_t offset,
+                    TELEMETRY_HEADER* header) {
+   TELEMETRY_HEADER next;
+
+   if (!isHeader(mapped, size, offset, header)) return false;
+   if (TELEMETRY_BLOCK_SIZE(header->count) > size - offset) return false;
+
+   size_t end = offset + TELEMETRY_BLOCK_SIZE(header->count);
+   return (size - end < sizeof(next)) || isHeader(mapped, size, end, &next);
+}
+
+/**
+ * Prints the summary.
+ *
+ * @param summary the summary in question
+ */
+static void printSummary(SUMMARY* summary) {
+   static const char* inputNames[TELEMETRY_INPUTS] = {
+      "none", "up", "right", "down", "left"
+   };
+   double games = summary->games ? (double)summary->games : 1.0;
+   double landings = summary->landings ? (double)summary->landings : 1.0;
+   uint64_t totalInputs = 0;
+
+   printf("Games:     %llu (in %llu blocks)\n",
+          (unsigned long long)summary->games,
+          (unsigned long long)summary->blocks);
+   printf("Crashes:   %llu (%.1f%%)\n", (unsigned long long)summary->crashes,
+          100.0 * summary->crashes / games);
+   printf("Landings:  %llu (%.1f%%)\n", (unsigned long long)summary->landings,
+          100.0 * summary->landings / games);
+   printf("Quits:     %llu (%.1f%%)\n", (unsigned long long)summary->quits,
+          100.0 * summary->quits / games);
+   printf("Ticks:     %.1f per game\n", summary->ticks / games);
+   printf("Fuel used: %.1f per game\n", summary->fuelUsed / games);
+   if (summary->skippedBytes > 0) {
+      printf("Damaged:   %llu bytes skipped in %llu places\n",
+             (unsigned long long)summary->skippedBytes,
+             (unsigned long long)summary->damagedPlaces);
+   }
+   if (summary->landings > 0) {
+      printf("Touchdown: %.3f mean |x|, %.3f mean y (%.3f to %.3f)\n",
+             summary->landingXMomentum / landings,
+             summary->landingYMomentum / landings,
+             summary->minLandingYMomentum, summary->maxLandingYMomentum);
+   }
+
+   for (int j = 0; j < TELEMETRY_INPUTS; j++) totalInputs += summary->inputs[j];
+   printf("Inputs:   ");
+   for (int j = 0; j < TELEMETRY_INPUTS; j++) {
+      printf(" %s %.1f%%", inputNames[j],
+             totalInputs ? 100.0 * summary->inputs[j] / totalInputs : 0.0);
+   }
+   printf("\n");
+}
+
+/**
+ * The main function of the analyser.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments; the first, if there is one, is the log to read
+ * @return 0 on success, 1 if the log couldn't be read
+ */
+int main(int argc, char* argv[]) {
+   const char* path = getenv(TELEMETRY_PATH_VAR);
+   if (argc > 1) path = argv[1];
+   else if (path == NULL) path = TELEMETRY_PATH;
+
+   int fd = open(path, O_RDONLY);
+   struct stat st;
+   if ((fd == -1) || (fstat(fd, &st) == -1)) {
+      perror(path);
+      return 1;
+   }
+
+   SUMMARY summary;
+   memset(&summary, 0, sizeof(summary));
+   summary.minLandingYMomentum = INFINITY;
+   summary.maxLandingYMomentum = -INFINITY;
+
+   // An empty log is perfectly valid, but `mmap()` won't have it.
+   if (st.st_size == 0) {
+      printSummary(&summary);
+      return 0;
+   }
+
+   const unsigned char* mapped = mmap(NULL, st.st_size, PROT_READ,
+                                      MAP_PRIVATE, fd, 0);
+   if (mapped == MAP_FAILED) {
+      perror(path);
+      return 1;
+   }
+   // The whole file is about to be read front to back.
+   madvise((void*)mapped, st.st_size, MADV_SEQUENTIAL);
+
+   struct timespec start, stop;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+
+   size_t offset = 0;
+   size_t size = st.st_size;
+   while (offset < size) {
+      TELEMETRY_HEADER header;
+
+      // Anything that doesn't look like a whole block is most likely a write
+      // that came up short (a full disk, say), and other games may well have
+      // carried on appending after it. Blocks are always a multiple of 8
+      // bytes long, so the hunt for the next one goes 8 bytes at a time.
+      if (!isBlock(mapped, size, offset, &header)) {
+         size_t bad = offset;
+         do {
+            offset += 8;
+         } while ((offset < size) && !isBlock(mapped, size, offset, &header));
+
+         if (offset >= size) {
+            fprintf(stderr, "%s: stopping at bad block at byte %zu\n", path,
+                    bad);
+            offset = size;
+         } else {
+            fprintf(stderr, "%s: skipping bad block at byte %zu\n", path,
+                    bad);
+         }
+         summary.skippedBytes += offset - bad;
+         summary.damagedPlaces++;
+         continue;
+      }
+
+      scanBlock(&summary, mapped + offset + sizeof(header), header.count);
+      offset += TELEMETRY_BLOCK_SIZE(header.count);
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &stop);
+   double seconds = (stop.tv_sec - start.tv_sec)
+                    + (stop.tv_nsec - start.tv_nsec) / 1e9;
+
+   printSummary(&summary);
+   printf("Scanned %zu bytes in %.3f s\n", offset, seconds);
+
+   munmap((void*)mapped, st.st_size);
+   close(fd);
+   return 0;
+}
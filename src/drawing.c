@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The bits of drawing that only need ncurses: rubbing out and drawing cells,
+ * and getting the particles onto the screen.
+ *
+ * Kept apart from `moonlander.c` so that `particlebench.c` can time them
+ * without the rest of the game.
+ */
+
+#include <math.h>
+#include <time.h>
+#include "drawing.h"
+
+/**
+ * Gives the time since `start`, in nanoseconds.
+ *
+ * @param start the time in question, from `CLOCK_MONOTONIC`
+ * @return the elapsed nanoseconds
+ */
+static long elapsed(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (now.tv_sec - start->tv_sec) * 1000000000L
+          + (now.tv_nsec - start->tv_nsec);
+}
+
+/**
+ * Copies the particles into a frame, ready to be drawn.
+ *
+ * Only the first `PARTICLE_DRAW_BUDGET` particles make it in, which keeps
+ * both the copying and the drawing from getting out of hand however big the
+ * explosion; any particles that miss out still move, they just aren't seen
+ * this frame.
+ *
+ * @param frame the frame in question
+ * @param particles the particle pool to copy
+ */
+void snapshotParticles(PARTICLE_FRAME* frame, PARTICLES* particles) {
+   size_t n = particles->count;
+   if (n > PARTICLE_DRAW_BUDGET) n = PARTICLE_DRAW_BUDGET;
+
+   for (size_t i = 0; i < n; i++) {
+      frame->x[i] = round(particles->x[i]);
+      frame->y[i] = round(particles->y[i]);
+      // Exhaust fades as it cools, and debris gets smaller as it settles.
+      if (particles->kind[i] == EXHAUST)
+         frame->glyph[i] = ((particles->life[i] > 2) ? ':' : '.')
+                           | COLOR_PAIR(1);
+      else
+         frame->glyph[i] = ((particles->life[i] > DEBRIS_LIFE / 2) ?
+                            '#' : ',') | COLOR_PAIR(2);
+   }
+   frame->count = n;
+}
+
+/**
+ * Rubs out whatever was drawn last frame.
+ *
+ * Only cells that still hold exactly what was drawn there are cleared, so
+ * anything drawn on top since (the ship, the HUD) survives.
+ *
+ * @param cells the cells in question
+ */
+void eraseCells(DRAWN_CELLS* cells) {
+   for (size_t i = 0; i < cells->count; i++) {
+      if (mvinch(cells->y[i], cells->x[i]) == cells->glyph[i])
+         mvaddch(cells->y[i], cells->x[i], ' ');
+   }
+   cells->count = 0;
+}
+
+/**
+ * Draws something in a cell, and remembers it so it can be rubbed out again.
+ *
+ * @param cells the cells in question
+ * @param x the x-coord to draw at
+ * @param y the y-coord to draw at
+ * @param glyph what to draw
+ */
+void drawCell(DRAWN_CELLS* cells, int x, int y, chtype glyph) {
+   if (cells->count >= PARTICLE_DRAW_BUDGET) return;
+
+   mvaddch(y, x, glyph);
+   cells->x[cells->count] = x;
+   cells->y[cells->count] = y;
+   cells->glyph[cells->count++] = glyph;
+}
+
+/**
+ * Draws the particles onto the screen.
+ *
+ * Particles are only drawn into empty cells, so they never scribble over the
+ * landscape. To keep a big explosion from eating into the next tick, drawing
+ * gives up altogether once `budget` nanoseconds have gone by.
+ *
+ * @param frame the frame holding the particles
+ * @param cells where to note the cells drawn in
+ * @param budget the most time to spend drawing, in nanoseconds
+ * @return how many particles were drawn
+ */
+size_t drawParticles(PARTICLE_FRAME* frame, DRAWN_CELLS* cells, long budget) {
+   struct timespec start;
+   size_t drawn = 0;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+
+   for (size_t i = 0; i < frame->count; i++) {
+      // Checking the clock is a syscall-ish faff, so only does it every so
+      // often.
+      if (((i & 63) == 63) && (elapsed(&start) > budget)) break;
+
+      int x = frame->x[i];
+      int y = frame->y[i];
+      if ((mvinch(y, x) & A_CHARTEXT) != ' ') continue;
+
+      drawCell(cells, x, y, frame->glyph[i]);
+      drawn++;
+   }
+   return drawn;
+}
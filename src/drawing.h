@@ -0,0 +1,64 @@
+#ifndef DRAWING_H_
+#define DRAWING_H_
+
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Header file for `drawing.c`.
+ *
+ * Needs ncurses, but knows nothing about the rest of the game, so that it can
+ * be linked into `particlebench.c` along with `particles.c`.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <ncurses.h>
+#include "particles.h"
+
+// Macros for keeping the particles from hogging the frame. At most
+// `PARTICLE_DRAW_BUDGET` particles get drawn per frame.
+#define PARTICLE_DRAW_BUDGET 2048
+
+// The cells something was drawn in last frame, so that they can be rubbed out
+// again without taking any of the landscape with them. There's one of these
+// each for the particles and the ship.
+typedef struct _drawn_cells_struct {
+   size_t count;
+   int x[PARTICLE_DRAW_BUDGET], y[PARTICLE_DRAW_BUDGET];
+   chtype glyph[PARTICLE_DRAW_BUDGET];
+}DRAWN_CELLS;
+
+// The particles as they're to be drawn for one frame: where each one is, and
+// what it looks like.
+typedef struct _particle_frame_struct {
+   size_t count;
+   int x[PARTICLE_DRAW_BUDGET], y[PARTICLE_DRAW_BUDGET];
+   chtype glyph[PARTICLE_DRAW_BUDGET];
+}PARTICLE_FRAME;
+
+// Drawing functions.
+void snapshotParticles(PARTICLE_FRAME* frame, PARTICLES* particles);
+void eraseCells(DRAWN_CELLS* cells);
+void drawCell(DRAWN_CELLS* cells, int x, int y, chtype glyph);
+size_t drawParticles(PARTICLE_FRAME* frame, DRAWN_CELLS* cells, long budget);
+
+#endif /* DRAWING_H_ */
@@ -32,12 +32,22 @@
  * - crashing & (rarely) landing
  * - cheats
  * - scoring
+ * - jet exhaust & crash debris
+ * - frame dropping on slow terminals
+ * - telemetry logging (see `analyser.c`)
+ * - trajectory prediction (press p in-game)
+ * - simulation on its own thread, so a slow terminal can't hold it up
  * 
  * Features to implement by TOMORROW are:
  * 
  * - more cheats (or 'debug modes' as all the kids are calling them these days)
  * - leaderboards
  * - random gravity generation
+ * 
+ * Build with:
+ * 
+ *    gcc -std=gnu11 -O3 moonlander.c drawing.c particles.c prediction.c \
+ *        telemetry.c -o moonlander -lncurses -lm -pthread
  */
 
 #include "moonlander.h"
@@ -45,7 +55,8 @@
 /**
  * The main function of the program.
  * 
- * Sets everything up initially, and then contains the game loop.
+ * Sets everything up initially, and then passes the game from state to
+ * state until the player quits.
  * 
  * @return 0 on success
  */
@@ -53,57 +64,153 @@ int main() {
    // Declarations of variables used throughout `main()`
    // With all this talk of `SHIP`s and `LANDSCAPE`s, it all
    // feels a bit object oriented around here.
-	SHIP ship;
+   // The game itself, which gets handed over to the simulation thread.
+   static GAME game;
+   // The exhaust and debris. It's `static` so that the whole pool is set
+   // aside once, rather than being shoved onto the stack or `malloc()`ed.
+   static PARTICLES particles;
+   // The snapshots the simulation passes over to be drawn.
+   static TRIPLE_BUFFER snapshots;
+   // Where the ship's heading.
+   static PREDICTION prediction;
+   // The log every game gets written to once it's over.
+   static TELEMETRY telemetry;
+   const char* telemetryPath;
+   // Where the game's at.
+   GAME_STATE state = INTRO;
+   
+   // This is where the magic happens.
+   initialisencurses();   
+   // This has to come after ncurses has had its go at the signals, and
+   // before the simulation thread exists to inherit the signal mask.
+   initialiseSignals();
+   // The pacer's and simulation's statistics are kept for the whole session,
+   // not per game, so that they show how the connection as a whole is
+   // holding up.
+   initialisePacer(&pacer);
+   jitter.ticks = 0;
+   jitter.total = 0;
+   jitter.worst = 0;
+   jitter.lateTicks = 0;
+   // Opens the telemetry log. If it can't be opened, that's a shame, but the
+   // game goes on.
+   if ((telemetryPath = getenv(TELEMETRY_PATH_VAR)) == NULL)
+      telemetryPath = TELEMETRY_PATH;
+   openTelemetry(&telemetry, telemetryPath);
+   
+   // The bits of the game that stick around from one game to the next. The
+   // player's choice of whether to see the prediction sticks too.
+   game.particles = &particles;
+   game.prediction = &prediction;
+   game.snapshots = &snapshots;
+   atomic_store(&game.showPrediction, false);
+   
+   // Each state runs until something happens to move the game on, and then
+   // says which state comes next. This used to be a `goto`, which I'm sure
+   // Dijkstra will be relieved to hear.
+   while (state != QUITTING) {
+      switch(state) {
+      case INTRO: state = runIntro(); break;
+      case PLAYING: state = playGame(&game, &telemetry); break;
+      case CRASHED: state = runCrashed(&game); break;
+      case LANDED: state = runLanded(&game); break;
+      case QUITTING: break;
+      }
+   }
+   
+   // Makes sure the last few games make it into the log.
+   closeTelemetry(&telemetry);
+   // Ends curses mode, else the terminal would play up afterwards (unless
+   // it's already had to be ended in a hurry).
+   if (!isendwin()) endwin();
+   // Owns up to how well the terminal coped, and how well the simulation
+   // coped with the terminal.
+   printf("Frames: %u drawn, %u dropped, %u snapshots missed\n",
+          pacer.framesDrawn, pacer.framesDropped, pacer.snapshotsMissed);
+   printf("Output queue: %d bytes peak, %llu bytes mean\n",
+          pacer.maxQueued, pacer.totalQueued
+          / ((pacer.framesDrawn + pacer.framesDropped) ?
+             (pacer.framesDrawn + pacer.framesDropped) : 1));
+   printf("Tick jitter: %lld us mean, %ld us worst; %u late ticks\n",
+          (jitter.ticks ? jitter.total / (long long)jitter.ticks : 0) / 1000,
+          jitter.worst / 1000, jitter.lateTicks);
+   // Then calls it a night.
+   return 0;
+}
+
+/**
+ * Shows the intro screen until the player starts a game.
+ * 
+ * Meanwhile, the keys for the available cheats can be used to toggle their
+ * effects.
+ * 
+ * @return the next state
+ */
+GAME_STATE runIntro() {
+   int ch;
+   
+   // The cheats have to be turned on afresh for every game.
+   invincible = false;
+   slowTerminal = false;
+   
+   // Displays the lovely nicked ASCII lunar lander splash screen.
+   displayIntro();
+   
+   for (;;) {
+      while ((ch = getch()) != ERR) {
+         if (ch == 'a') {
+            return PLAYING;
+         } else if (ch == 'i') {
+            invincible = (invincible) ? false : true;
+            mvaddch(LINES-1, COLS-1, (invincible) ? 'T' : 'F');
+         } else if (ch == 's') {
+            slowTerminal = (slowTerminal) ? false : true;
+            mvaddch(LINES-1, COLS-2, (slowTerminal) ? 'S' : ' ');
+         }
+      }
+      // There's nothing moving on the intro screen, so there's nothing to do
+      // until the player presses something.
+      if ((waitForInput(-1) == INPUT_LOST) || hungUp) return QUITTING;
+   }
+}
+
+/**
+ * Plays a game from start to finish.
+ * 
+ * @param game the game in question
+ * @param telemetry the log to write the game to once it's over
+ * @return the next state
+ */
+GAME_STATE playGame(GAME* game, TELEMETRY* telemetry) {
 	LANDSCAPE landscape;   
-   // Values used for tracking the score.
-   unsigned int time;
-   // Used for animating the game.
-   s.tv_sec = 0;
-   s.tv_nsec = 180000000L;
+   SNAPSHOT* latest;
+   unsigned long lastTick;
+   pthread_t simulation;
+   TELEMETRY_RECORD record;
    // Used for recording user input.
-   unsigned int ch;
-   // Used for moving the ship.
-   unsigned int jetDir;
+   int ch;
+   // Whether the player wants to see where the ship's heading.
+   bool showPrediction = atomic_load(&game->showPrediction);
+   // Whether the terminal's gone, and so there's no point waiting on it.
+   bool terminalLost = false;
+   struct timespec renderWait;
+   renderWait.tv_sec = 0;
+   renderWait.tv_nsec = RENDER_INTERVAL;
    // Used for dealing with the landscape arrays.
    size_t lASize, sASize;
-   // Tracks the score.
-   double score;
    
-   // This is where the magic happens.
-   initialisencurses();   
- 
-// I know, I know; 'Go To Statement Considered Harmful' and
-// all that. I feel like even Dijkstra would let me off for this
-// one though.
-restart:  
    // (Re-)Initialises the relevant variables; the user isn't always coming
    // to this point fresh.
    end = false;
    endType = NONE;
-   time = 0;
-   invincible = false;
-   ch = ' ';
-   jetDir = NONE; 
-   score = 0.0f;
+   game->time = 0;
+   for (size_t i = 0; i < TELEMETRY_INPUTS; i++) game->inputs[i] = 0;
    
    // `lASize` is initialised to 1 rather than 0 because the first coordinates
    // in `landscapeArray` will be the leftmost ones; that is, they will have a
    // x-coord of 0 and the size of the array will return as 0.
    lASize = 1;
    sASize = 0;
-   
-   // Displays the lovely nicked ASCII lunar lander splash screen.
-   displayIntro();
-   
-   // Loops whilst on the intro screen until the button to start the
-   // game is pressed. Meanwhile, the keys for the available cheats
-   // can be used to toggle their effects.
-   while ((ch = getch()) != 'a'){
-      if (ch == 'i') {
-         invincible = (invincible) ? false : true;
-         mvaddch(LINES-1, COLS-1, (invincible) ? 'T' : 'F');
-      }      
-   }
 
    // Wipes the slate clean.
    clear();
@@ -115,8 +222,12 @@ restart:
    
    // Initialises the parameters for the ship and landscape; did 
    // someone say object constructors?
-	initialiseShip(&ship);
+	initialiseShip(&game->ship);
 	initialiseLandscape(&landscape);
+   initialiseParticles(game->particles);
+   initialiseSnapshots(game->snapshots);
+   particleCells.count = 0;
+   shipCells.count = 0;
    
    // Seriously, who designed this thing?
 	attron(COLOR_PAIR(1));
@@ -147,73 +258,273 @@ restart:
    // but I'm lazy. So sue me.
    do { lASize++; } while (landscapeArray[lASize] != 0); --lASize;
    do { sASize++; } while (safeArray[sASize] != 0); --sASize;
+   // Maps out the landscape cell-by-cell, so the trajectory prediction can
+   // tell whether a point hits it without trawling through `landscapeArray`.
+   unsigned char terrain[COLS * LINES];
+   for (size_t i = 0; i < COLS * LINES; i++) terrain[i] = 0;
+   for (size_t i = 0; i < lASize; i += 2) {
+      if ((landscapeArray[i] < COLS) && (landscapeArray[i + 1] < LINES))
+         terrain[landscapeArray[i + 1] * COLS + landscapeArray[i]] = 1;
+   }
+   resetPrediction(game->prediction, PREDICTION_HORIZON, COLS, LINES);
+   // The renderer's side of the prediction; nothing's been drawn yet, and
+   // the simulation knows it.
+   unsigned short trailCounts[COLS * LINES];
+   resetTrail(&trail, trailCounts, COLS, LINES);
+   for (int i = 0; i < HUD_ROWS; i++) hudEnds[i] = 0;
+   game->sentGeneration = 0;
+   game->sentEnd = 0;
+   game->seenGeneration = 0;
+   game->seenEnd = 0;
    
    // Does what it says on the tin, really.
-	createShip(&ship);
+	createShip(&game->ship);
    
    // Sticks all of this onto the screen.
 	refresh();
    
+   // Hands the game over to the simulation thread. From here until the
+   // game's over, this thread does nothing but pass keys one way and draw
+   // snapshots coming back the other, so however long the terminal takes to
+   // draw, the simulation keeps ticking on time.
+   game->lASize = lASize;
+   game->sASize = sASize;
+   game->landscapeArray = landscapeArray;
+   game->safeArray = safeArray;
+   game->terrain = terrain;
+   game->cols = COLS;
+   game->lines = LINES;
+   atomic_store(&game->jetRequest, NONE);
+   atomic_store(&game->quitRequest, false);
+   int error = pthread_create(&simulation, NULL, simulate, game);
+   // Without the simulation, nothing would ever get drawn and the game would
+   // never end, so there's nothing for it but to give up.
+   if (error != 0) {
+      endwin();
+      fprintf(stderr, "Couldn't start the simulation: %s\n", strerror(error));
+      return QUITTING;
+   }
+   
    // Despite what I said before, this is where the magic really happens.
    // The fabled game loop.
+   latest = NULL;
    do {  
-      // If a direction key is entered, the jet direction is set to that key's
-      // direction. If F1 is entered, the QUIT endstate is triggered. If no
-      // key is entered, the jets are turned off.
-      if ((ch = getch()) != ERR) {
+      // If the terminal's gone, the game's over.
+      if (hungUp) atomic_store(&game->quitRequest, true);
+      // If a direction key is entered, the jets are fired in that direction
+      // on the next tick. If F1 is entered, the QUIT endstate is triggered on
+      // the next tick. If no key is entered by then, the jets are turned off.
+      while ((ch = wgetch(input)) != ERR) {
          switch(ch) {
-         case KEY_UP: jetDir = UP; break;
-         case KEY_RIGHT: jetDir = RIGHT; break;
-         case KEY_DOWN: jetDir = DOWN; break;
-         case KEY_LEFT: jetDir = LEFT; break;
-         case KEY_F(1): end = true; endType = QUIT; break;
+         case KEY_UP: atomic_store(&game->jetRequest, UP); break;
+         case KEY_RIGHT: atomic_store(&game->jetRequest, RIGHT); break;
+         case KEY_DOWN: atomic_store(&game->jetRequest, DOWN); break;
+         case KEY_LEFT: atomic_store(&game->jetRequest, LEFT); break;
+         case KEY_F(1): atomic_store(&game->quitRequest, true); break;
+         case 'p':
+            showPrediction = (showPrediction) ? false : true;
+            atomic_store(&game->showPrediction, showPrediction);
+            break;
          }
-      } else jetDir = NONE;   
-      // If the jets should be on, turns them on.
-      if (jetDir != NONE) {
-         applyJet(&ship, jetDir);
-      }      
-      // Like death and taxes, there's no getting away from gravity
-      // and friction.
-      applyGravity(&ship);
-      applyFriction(&ship);
-      // Figures out where the ship ought to be now.
-      moveShip(&ship, lASize, landscapeArray, sASize, safeArray);
-      // Updates the clock, ticking up mercilessly all the while.
-      mvprintw(3, 1, "Time: %d", time++);
-      // Slows the program down to human-comprehendable speed.
-      nanosleep(&s, NULL);      
-   } while (!end);
-      
-   // If a game end is triggers, tests what flavour of end it is.
+      }
+      // Draws the latest tick, if there's been one since last time, and sends
+      // it to the terminal if the terminal can take it.
+      SNAPSHOT* snapshot = acquireSnapshot(game->snapshots);
+      if (snapshot != NULL) {
+         // Any ticks skipped over happened whilst this thread was still busy
+         // drawing; the simulation didn't wait for it.
+         if ((latest != NULL) && (snapshot->tick > lastTick + 1))
+            pacer.snapshotsMissed += snapshot->tick - lastTick - 1;
+         latest = snapshot;
+         lastTick = latest->tick;
+         drawFrame(latest, safeArray);
+         presentFrame(&pacer);
+      // Otherwise waits for the next snapshot, but wakes straight away if a
+      // key comes in before then. If the terminal's gone, the game's over,
+      // and there's nothing to do but wait for the simulation to notice.
+      } else if (terminalLost) {
+         nanosleep(&renderWait, NULL);
+      } else if (waitForInput(RENDER_INTERVAL) == INPUT_LOST) {
+         terminalLost = true;
+         atomic_store(&game->quitRequest, true);
+      }
+   } while ((latest == NULL) || !latest->end);
+   // The simulation's done once it's sent its last snapshot, so from here on
+   // `game` belongs to this thread again.
+   pthread_join(simulation, NULL);
+   
+   // Writes the game up for posterity.
+   record.seed = seed;
+   record.ticks = game->time;
+   record.fuelUsed = STARTING_FUEL - game->ship.fuel;
+   record.xMomentum = game->ship.xMomentum;
+   record.yMomentum = game->ship.yMomentum;
+   for (size_t i = 0; i < TELEMETRY_INPUTS; i++)
+      record.inputs[i] = game->inputs[i];
+   record.endType = endType;
+   logGame(telemetry, &record);
+   
+   // Tests what flavour of end it was. The landscape arrays go out of scope
+   // here, but nothing after this needs them.
    switch(endType) {
-   case CRASH:      
-      attron(COLOR_PAIR(2));
-      mvprintw(6, COLS/3, "AW MAAAAN");
-      attroff(COLOR_PAIR(2));      
-      mvprintw(7, COLS/3, "Press r to restart");
-      
-      while ((ch = getch()) != 'r'){}
-      // I'm so sorry Edsger.
-      goto restart;
-   case LAND:
-      score = getScore(&ship, time);
-      attron(COLOR_PAIR(3));
-      mvprintw(6, COLS/3, "YOU LANDED");
-      attroff(COLOR_PAIR(3));
-      mvprintw(7, COLS/3, "Your score: %f", score);
-      mvprintw(8, COLS/3, "Press r to restart");
+   case CRASH: return CRASHED;
+   case LAND: return LANDED;
+   default: return QUITTING;
+   }
+}
+
+/**
+ * Blows the ship up, and lets the bits settle whilst waiting for the player
+ * to try again.
+ * 
+ * @param game the game that's just ended
+ * @return the next state
+ */
+GAME_STATE runCrashed(GAME* game) {
+   // The debris gets drawn straight from its own frame, since the
+   // simulation's finished with by now.
+   static PARTICLE_FRAME debris;
+   struct timespec lastStep;
+   long wait;
+   int ch;
+   
+   attron(COLOR_PAIR(2));
+   mvprintw(6, COLS/3, "AW MAAAAN");
+   attroff(COLOR_PAIR(2));      
+   mvprintw(7, COLS/3, "Press r to restart");
+   refresh();
+   
+   emitDebris(game->particles, game->ship.xF, game->ship.yF,
+              game->ship.xMomentum, game->ship.yMomentum);
+   clock_gettime(CLOCK_MONOTONIC, &lastStep);
+   
+   for (;;) {
+      while ((ch = getch()) != ERR) {
+         if (ch == 'r') return INTRO;
+      }
       
-      while ((ch = getch()) != 'r'){}
-      goto restart;
-   case QUIT:
-      // Ends curses mode, else the terminal would play up afterwards.
-      endwin();
-      // Then calls it a night.
-      return 0;
+      // Moves the debris along once a tick for as long as there's any left,
+      // however many keys get pressed in between. Once it's all settled,
+      // there's nothing to wake up for but the player.
+      wait = -1;
+      if (game->particles->count > 0) {
+         wait = TICK_INTERVAL - nsSince(&lastStep);
+         if (wait <= 0) {
+            eraseCells(&particleCells);
+            updateParticles(game->particles, COLS, LINES);
+            snapshotParticles(&debris, game->particles);
+            drawParticles(&debris, &particleCells, PARTICLE_TIME_BUDGET);
+            refresh();
+            clock_gettime(CLOCK_MONOTONIC, &lastStep);
+            wait = TICK_INTERVAL;
+         }
+      }
+      if ((waitForInput(wait) == INPUT_LOST) || hungUp) return QUITTING;
+   }
+}
+
+/**
+ * Shows the player their score whilst waiting for them to go again.
+ * 
+ * @param game the game that's just ended
+ * @return the next state
+ */
+GAME_STATE runLanded(GAME* game) {
+   int ch;
+   
+   attron(COLOR_PAIR(3));
+   mvprintw(6, COLS/3, "YOU LANDED");
+   attroff(COLOR_PAIR(3));
+   mvprintw(7, COLS/3, "Your score: %f", getScore(&game->ship, game->time));
+   mvprintw(8, COLS/3, "Press r to restart");
+   refresh();
+   
+   for (;;) {
+      while ((ch = getch()) != ERR) {
+         if (ch == 'r') return INTRO;
+      }
+      if ((waitForInput(-1) == INPUT_LOST) || hungUp) return QUITTING;
    }
 }
 
+/**
+ * Waits for the player to press something.
+ * 
+ * ncurses only ever gets asked for keys without waiting, so rather than
+ * asking it over and over, this sleeps in `ppoll()` until there's something
+ * to read from the terminal. Anything ncurses has already read in has to be
+ * dealt with before calling this, since `ppoll()` won't know about it.
+ * 
+ * Once the terminal's hung up, `ppoll()` says so straight away every time
+ * whilst `getch()` never has anything to give, so the caller has to give up
+ * on it rather than go round again.
+ * 
+ * This is also the only place the hang up signals are let through, so the
+ * wait gets cut short by one and `hungUp` wants checking afterwards. The
+ * signal only gets handled if the terminal had nothing to say, though, and a
+ * terminal that's hung up always has; `INPUT_LOST` covers that case.
+ * 
+ * @param timeout the most nanoseconds to wait for, or -1 to wait for ever
+ * @return `INPUT_READY` if there's something to read, `INPUT_LOST` if the
+ * terminal's gone, or `INPUT_TIMEOUT` if the wait ran out (or was
+ * interrupted)
+ */
+INPUT_STATE waitForInput(long timeout) {
+   struct pollfd keys;
+   struct timespec wait;
+   keys.fd = STDIN_FILENO;
+   keys.events = POLLIN;
+   wait.tv_sec = timeout / 1000000000L;
+   wait.tv_nsec = timeout % 1000000000L;
+   
+   if (ppoll(&keys, 1, (timeout < 0) ? NULL : &wait, &waitMask) <= 0)
+      return INPUT_TIMEOUT;
+   if (keys.revents & (POLLHUP | POLLERR | POLLNVAL)) return INPUT_LOST;
+   return INPUT_READY;
+}
+
+/**
+ * Catches the signals that mean the session's over, so that the game can
+ * finish up properly.
+ * 
+ * An SSH connection dropping is the usual way a game ends, and the default
+ * there is to die on the spot, before the last batch of telemetry is written.
+ * The same goes for Ctrl-C (or Ctrl-\), since `cbreak()` leaves those
+ * working. Anything that was already ignoring them (`nohup`, say) is left
+ * ignoring them.
+ */
+void initialiseSignals() {
+   int signals[] = { SIGHUP, SIGTERM, SIGINT, SIGQUIT };
+   struct sigaction action, old;
+   sigset_t hangUps;
+   
+   action.sa_handler = handleHangUp;
+   sigemptyset(&action.sa_mask);
+   action.sa_flags = 0;
+   sigemptyset(&hangUps);
+   
+   for (size_t i = 0; i < sizeof(signals) / sizeof(signals[0]); i++) {
+      sigaction(signals[i], NULL, &old);
+      if (old.sa_handler == SIG_IGN) continue;
+      sigaction(signals[i], &action, NULL);
+      sigaddset(&hangUps, signals[i]);
+   }
+   
+   // Keeps them out except whilst waiting for keys; see `waitMask`.
+   pthread_sigmask(SIG_BLOCK, &hangUps, &waitMask);
+}
+
+/**
+ * Notes that the session's over. All the actual finishing up happens back
+ * in the states, since hardly anything is safe to do in here.
+ * 
+ * @param signal the signal that was caught
+ */
+void handleHangUp(int signal) {
+   (void)signal;
+   hungUp = 1;
+}
+
 /**
  * Initialises ncurses.
  * 
@@ -238,6 +549,12 @@ void initialisencurses() {
 	noecho();
    // Hides the cursor.
    curs_set(0);
+   
+   // Sets up the window the game reads its keys from. It needs the same
+   // treatment as `stdscr`.
+   input = newwin(1, 1, 0, 0);
+   nodelay(input, TRUE);
+   keypad(input, TRUE);
 }
 
 /**
@@ -330,8 +647,10 @@ bool createLandscape(LANDSCAPE* landscape, unsigned int landscapeArray[],
       for(int i = x; i <= x + w; ++i)
          mvaddch(j, i, ' ');
    
-   // Seeds C's psuedorandom number generator.
-   srand(time(NULL));
+   // Seeds C's psuedorandom number generator, remembering the seed so that
+   // the telemetry can say which landscape a game was played on.
+   seed = time(NULL);
+   srand(seed);
    
    // Starts the landscape off with a fruity left incline.
    landscapeArray[0] = x; landscapeArray[1] = y;
@@ -444,13 +763,6 @@ void applyJet(SHIP* ship, unsigned int dir) {
    if (ship->fuel > 0) {
       ship->fuel--;
       
-      // Shows the player their remaining fuel balance.
-      if (ship->fuel == 0)
-         attron(COLOR_PAIR(2));
-      mvprintw(2,1,"Fuel: %d", ship->fuel);
-      if (ship->fuel == 0)
-         attroff(COLOR_PAIR(2));
-
       // Adds a bit of momentum in the chosen direction.
       switch(dir) {
       case UP:
@@ -471,7 +783,9 @@ void applyJet(SHIP* ship, unsigned int dir) {
  * @param ship the ship in question
  */
 void applyGravity(SHIP* ship) {
-   if (ship->yMomentum <= TERMINAL_VELOCITY) ship->yMomentum += 0.05f;
+   // The sums themselves live in `prediction.c`, so that the prediction can
+   // never disagree with the ship about them.
+   ship->yMomentum = applyGravityTo(ship->yMomentum);
 }
 
 /**
@@ -480,17 +794,268 @@ void applyGravity(SHIP* ship) {
  * @param ship the ship in question
  */
 void applyFriction(SHIP* ship) {
-   // Takes off a bit of the up/down speed.
-   if (ship->yMomentum > 0.0f)
-      ship->yMomentum -= 0.025f;
-   else 
-      ship->yMomentum += 0.025f;
+   // Takes off a bit of the up/down speed, then does the same for the
+   // left/right speed.
+   ship->yMomentum = applyFrictionTo(ship->yMomentum);
+   ship->xMomentum = applyFrictionTo(ship->xMomentum);
+}
+
+/**
+ * Emits a puff of exhaust out of the back of the jet.
+ * 
+ * If the ship is out of fuel, there's nothing to puff. This needs calling
+ * before `applyJet()`, else the last drop of fuel goes unseen.
+ * 
+ * @param particles the particle pool to emit into
+ * @param ship the ship in question
+ * @param dir the thrust direction
+ */
+void emitJetExhaust(PARTICLES* particles, SHIP* ship, unsigned int dir) {
+   if (ship->fuel <= 0) return;
+   
+   // The exhaust goes the opposite way to the thrust.
+   switch(dir) {
+   case UP:
+      emitExhaust(particles, ship->xF, ship->yF, 0.0f, 1.0f); break;
+   case RIGHT:
+      emitExhaust(particles, ship->xF, ship->yF, -1.0f, 0.0f); break;
+   case DOWN:
+      emitExhaust(particles, ship->xF, ship->yF, 0.0f, -1.0f); break;
+   case LEFT:
+      emitExhaust(particles, ship->xF, ship->yF, 1.0f, 0.0f); break;
+   }
+}
+
+/**
+ * Forgets the predicted path that's been drawn, without rubbing it out; for
+ * when the screen's being cleared anyway.
+ * 
+ * @param trail the trail in question
+ * @param counts somewhere to count the points in each cell, `cols` by `lines`
+ * @param cols the width of the screen
+ * @param lines the height of the screen
+ */
+void resetTrail(TRAIL* trail, unsigned short counts[], int cols, int lines) {
+   trail->drawn = false;
+   trail->generation = 0;
+   trail->first = 0;
+   trail->end = 0;
+   trail->cols = cols;
+   trail->lines = lines;
+   trail->counts = counts;
+   for (size_t i = 0; i < (size_t)cols * lines; i++) counts[i] = 0;
+}
+
+/**
+ * Adds a point onto the end of the drawn path. Like the particles, the path
+ * only goes into empty cells.
+ * 
+ * @param trail the trail in question
+ * @param x the point's x-coord
+ * @param y the point's y-coord
+ */
+static void addTrailPoint(TRAIL* trail, int x, int y) {
+   size_t i = trail->end++ % PREDICTION_HORIZON;
+   trail->x[i] = x;
+   trail->y[i] = y;
+   
+   // Points above the top of the screen are still kept, since they'll have
+   // to be dropped again later, but there's nothing to draw.
+   if ((x < 0) || (x >= trail->cols) || (y < 0) || (y >= trail->lines))
+      return;
+   if ((trail->counts[y * trail->cols + x]++ == 0) && (mvinch(y, x) == ' '))
+      mvaddch(y, x, PREDICTION_GLYPH);
+}
+
+/**
+ * Drops the first point off the drawn path, rubbing it out if it was the
+ * last one in its cell.
+ * 
+ * @param trail the trail in question
+ */
+static void dropTrailPoint(TRAIL* trail) {
+   size_t i = trail->first++ % PREDICTION_HORIZON;
+   int x = trail->x[i];
+   int y = trail->y[i];
+   
+   if ((x < 0) || (x >= trail->cols) || (y < 0) || (y >= trail->lines))
+      return;
+   if ((--trail->counts[y * trail->cols + x] == 0) &&
+       (mvinch(y, x) == PREDICTION_GLYPH))
+      mvaddch(y, x, ' ');
+}
+
+/**
+ * Puts a dot back in a cell that something else has been drawn over and
+ * rubbed out again, if the path still goes through it.
+ * 
+ * @param trail the trail in question
+ * @param x the x-coord of the cell
+ * @param y the y-coord of the cell
+ */
+void restoreTrailCell(TRAIL* trail, int x, int y) {
+   if ((x < 0) || (x >= trail->cols) || (y < 0) || (y >= trail->lines))
+      return;
+   if ((trail->counts[y * trail->cols + x] > 0) && (mvinch(y, x) == ' '))
+      mvaddch(y, x, PREDICTION_GLYPH);
+}
+
+/**
+ * Brings the predicted path on the screen up to date with a snapshot.
+ * 
+ * Only the points that have been dropped off the front are rubbed out, and
+ * only the ones that have been added on the end are drawn, so whilst the
+ * ship's coasting this is a couple of cells a frame however long the path.
+ * Only a whole new path (after the jets have fired) means redrawing the lot.
+ * 
+ * @param snapshot the snapshot holding the prediction
+ */
+void drawPrediction(SNAPSHOT* snapshot) {
+   unsigned long from = snapshot->predictionFrom;
+   unsigned long end = from + snapshot->predictionCount;
+   
+   // A whole new path; the old one goes altogether.
+   if (!trail.drawn || (trail.generation != snapshot->predictionGeneration)) {
+      while (trail.first < trail.end) dropTrailPoint(&trail);
+      trail.drawn = true;
+      trail.generation = snapshot->predictionGeneration;
+      trail.first = from;
+      trail.end = from;
+   }
+   
+   // Drops whatever's fallen off the front since last time.
+   while ((trail.first < snapshot->predictionFirst) &&
+          (trail.first < trail.end))
+      dropTrailPoint(&trail);
+   // The snapshot ought to carry on from where the trail stops, or go over
+   // some of the same ground again; if there's somehow a gap, the trail
+   // starts over from the snapshot.
+   if (trail.end < from) {
+      while (trail.first < trail.end) dropTrailPoint(&trail);
+      trail.first = from;
+      trail.end = from;
+   }
    
-   // Then does the same for the left/right speed.
-   if (ship->xMomentum > 0.0f)
-      ship->xMomentum -= 0.025f;
-   else 
-      ship->xMomentum += 0.025f;
+   // Adds on whatever's new.
+   while (trail.end < end) {
+      size_t i = trail.end - from;
+      addTrailPoint(&trail, snapshot->predictionX[i], snapshot->predictionY[i]);
+   }
+}
+
+/**
+ * Notes how far along a row the heads-up display has just written to.
+ * 
+ * @param row the row in question, which the cursor should still be on
+ */
+void noteHudRow(int row) {
+   int end = getcurx(stdscr);
+   if ((row < HUD_ROWS) && (end > hudEnds[row])) hudEnds[row] = end;
+}
+
+/**
+ * Blanks whatever the heads-up display has written along a row, and puts
+ * back any of the predicted path it had been covering.
+ * 
+ * @param row the row in question
+ */
+void hideHudRow(int row) {
+   if (row >= HUD_ROWS) return;
+   for (int x = 1; x < hudEnds[row]; x++) {
+      mvaddch(row, x, ' ');
+      restoreTrailCell(&trail, x, row);
+   }
+   hudEnds[row] = 0;
+}
+
+/**
+ * Draws a snapshot of the game.
+ * 
+ * Whatever the last snapshot drew is rubbed out first, so there's no need for
+ * the snapshots to be drawn one after the other; if some get skipped, the
+ * screen still comes out right.
+ * 
+ * @param snapshot the snapshot in question
+ * @param safeArray the array of coordinates for the components of the
+ * landing pad(s)
+ */
+void drawFrame(SNAPSHOT* snapshot, unsigned int safeArray[]) {
+   int x = snapshot->x;
+   int y = snapshot->y;
+   
+   // The predicted path isn't rubbed out; it only changes a bit at a time,
+   // so it's kept on the screen, bar wherever the ship just was.
+   bool shipDrawn = (shipCells.count > 0);
+   int oldX = shipCells.x[0];
+   int oldY = shipCells.y[0];
+   eraseCells(&shipCells);
+   if (shipDrawn) restoreTrailCell(&trail, oldX, oldY);
+   eraseCells(&particleCells);
+   
+   // Shows the player their momentum, remaining fuel balance and time, plus
+   // a whole load of debugging gubbins, unless the terminal is too bogged
+   // down to be bothered with it. Once it is, whatever was last shown is
+   // blanked the once, rather than left there going stale.
+   if (pacer.lowDetail && !pacer.wasLowDetail) {
+      int hidden[] = { 1, 4, 5, 11, 12, 13, 15 };
+      for (size_t i = 0; i < sizeof(hidden) / sizeof(hidden[0]); i++)
+         hideHudRow(hidden[i]);
+   }
+   pacer.wasLowDetail = pacer.lowDetail;
+   if (!pacer.lowDetail) {
+      mvprintw(1,1,"Momentum: %f,%f", snapshot->xMomentum, snapshot->yMomentum);
+      noteHudRow(1);
+      mvprintw(11, 1, "%d, %d", safeArray[0], safeArray[1]);
+      noteHudRow(11);
+      mvprintw(12, 1, "%d, %d", safeArray[8], safeArray[9]);
+      noteHudRow(12);
+      mvprintw(13, 1, "%d, %d", safeArray[16], safeArray[17]);
+      noteHudRow(13);
+      mvprintw(15, 1, "%d, %d", x, y);
+      noteHudRow(15);
+   }
+   if (snapshot->fuel == 0)
+      attron(COLOR_PAIR(2));
+   mvprintw(2,1,"Fuel: %d ", snapshot->fuel);
+   if (snapshot->fuel == 0)
+      attroff(COLOR_PAIR(2));
+   // Updates the clock, ticking up mercilessly all the while.
+   mvprintw(3, 1, "Time: %d", snapshot->time);
+   if (!pacer.lowDetail) {
+      mvprintw(4, 1, "Frames: %u drawn, %u dropped, %d bytes queued",
+               pacer.framesDrawn, pacer.framesDropped, pacer.queued);
+      noteHudRow(4);
+      mvprintw(5, 1, "Jitter: %ld us mean, %ld us worst, %u late ticks  ",
+               snapshot->meanJitter / 1000, snapshot->worstJitter / 1000,
+               snapshot->lateTicks);
+      noteHudRow(5);
+   }
+   
+   // The path goes down before the exhaust, so that the exhaust can't take
+   // up a cell the path has just reached and then leave it empty.
+   drawPrediction(snapshot);
+   // If the terminal is struggling, the exhaust still moves but isn't shown.
+   if (!pacer.lowDetail)
+      drawParticles(&snapshot->particles, &particleCells,
+                    PARTICLE_TIME_BUDGET);
+   
+   // Draws the ship at its new coordinates, coloured in red if it's crashed.
+   chtype bod = '*' | A_BOLD;
+   if (snapshot->endType == CRASH)
+      bod |= COLOR_PAIR(2);
+   else if (snapshot->endType == LAND)
+      bod |= COLOR_PAIR(3);
+   drawCell(&shipCells, x, y, bod);
+   
+   // If the ship has exceeded the top of the screen, adds a small arrow 
+   // to show the column the ship is in.
+   for (int i = 0; i <= COLS; i++)
+      mvaddch(0, i, ' ');
+   if (y < 0)
+      mvaddch(0, x, '^' | A_BOLD);
+   attron(COLOR_PAIR(1));
+   mvprintw(0, 1, "Press F1 to exit");
+   attroff(COLOR_PAIR(1));
 }
 
 /**
@@ -509,24 +1074,10 @@ void moveShip(SHIP* ship, size_t lASize, unsigned int landscapeArray[],
    // Adds the ships momentum to its current location.
    ship->xF += ship->xMomentum;
    ship->yF += ship->yMomentum;
-   
-   // Displays the momentum for the player.
-	mvprintw(1,1,"Momentum: %f,%f", ship->xMomentum, ship->yMomentum);
    	
    // Rounds the floating point coordinates to the nearest integer coords
 	signed int x = round(ship->xF);
 	signed int y = round(ship->yF);
-   // Gets the coordinates the ship used to be at.
-   signed int prevX = ship->lastx;
-   signed int prevY = ship->lasty;
-   
-   // Deletes the ship from its old coordinates.
-   mvaddch(prevY, prevX, ' ');
-   
-   mvprintw(11, 1, "%d, %d", safeArray[0], safeArray[1]);
-   mvprintw(12, 1, "%d, %d", safeArray[8], safeArray[9]);
-   mvprintw(13, 1, "%d, %d", safeArray[16], safeArray[17]);
-   mvprintw(15, 1, "%d, %d", x, y);
    
    // Runs though the `landscapeArray` to see the the ship's new location
    // means a collision with any landscape features.
@@ -559,43 +1110,303 @@ void moveShip(SHIP* ship, size_t lASize, unsigned int landscapeArray[],
       }
    }
    
-   // Colours the ship in red if it's crashed.
-   if (endType == CRASH)
-      attron(COLOR_PAIR(2));
-   else if (endType == LAND)
-      attron(COLOR_PAIR(3));
-   // Draws the ship at its new coordinates.
-   mvaddch(y, x, ship->graphics.bod | A_BOLD);	
-   if (endType == CRASH)
-      attroff(COLOR_PAIR(2));
-   else if (endType == LAND)
-      attroff(COLOR_PAIR(3));
-   
-   // If the ship has exceeded the top of the screen, adds a small arrow 
-   // to show the column the ship is in.
-   if (y < 0) {
-      for (int i = 0; i <= COLS; i++)
-         mvaddch(0, i, ' ');
-      mvaddch(0, x, '^' | A_BOLD);
-      attron(COLOR_PAIR(1));
-      mvprintw(0, 1, "Press F1 to exit");
-      attroff(COLOR_PAIR(1));
-   } else {
-      for (int i = 0; i <= COLS; i++)
-         mvaddch(0, i, ' ');
-      attron(COLOR_PAIR(1));
-      mvprintw(0, 1, "Press F1 to exit");
-      attroff(COLOR_PAIR(1));
-   }
-   
    // Stores the new coordinates for comparison next time the function is run.
    ship->lastx = x;
    ship->lasty = y;
-   
-   // Pushes the new ship to the terminal.
-	refresh();
 } 
 
+/**
+ * Runs a game, one tick at a time, until it's over.
+ * 
+ * This is the simulation thread. It does all of the physics and collision
+ * detection, but never touches ncurses; instead, at the end of every tick it
+ * publishes a snapshot of the game for the main thread to draw whenever it
+ * can. Keys come the other way through `game`'s atomics.
+ * 
+ * @param game the game in question
+ * @return nothing
+ */
+void* simulate(void* game) {
+   GAME* g = game;
+   SHIP* ship = &g->ship;
+   struct timespec deadline;
+   unsigned int jetDir;
+   
+   clock_gettime(CLOCK_MONOTONIC, &deadline);
+   do {
+      // Fires the jets if a direction key has been pressed since the last
+      // tick, and turns them off if not.
+      jetDir = atomic_exchange(&g->jetRequest, NONE);
+      if (atomic_load(&g->quitRequest)) {
+         end = true;
+         endType = QUIT;
+      }
+      g->inputs[jetDir]++;
+      // If the jets should be on, turns them on.
+      if (jetDir != NONE) {
+         emitJetExhaust(g->particles, ship, jetDir);
+         applyJet(ship, jetDir);
+      }
+      // Like death and taxes, there's no getting away from gravity
+      // and friction.
+      applyGravity(ship);
+      applyFriction(ship);
+      // Moves the exhaust along in one go.
+      updateParticles(g->particles, g->cols, g->lines);
+      // Figures out where the ship ought to be now.
+      moveShip(ship, g->lASize, g->landscapeArray, g->sASize, g->safeArray);
+      // Works out where it's going to be.
+      if (atomic_load(&g->showPrediction) && !end)
+         updatePrediction(g->prediction, ship->xF, ship->yF, ship->xMomentum,
+                          ship->yMomentum, jetDir == NONE, g->terrain);
+      else resetPrediction(g->prediction, PREDICTION_HORIZON, g->cols,
+                           g->lines);
+      
+      // Hands the tick over to be drawn. If the last snapshot got picked up,
+      // the renderer's got everything that went out in it, and the next one
+      // only needs to carry what's new since.
+      SNAPSHOT* snapshot = &g->snapshots->buffers[g->snapshots->back];
+      takeSnapshot(g, snapshot);
+      if (publishSnapshot(g->snapshots)) {
+         g->seenGeneration = g->sentGeneration;
+         g->seenEnd = g->sentEnd;
+      }
+      g->sentGeneration = snapshot->predictionGeneration;
+      g->sentEnd = snapshot->predictionFrom + snapshot->predictionCount;
+      g->time++;
+      
+      // Slows the program down to human-comprehendable speed.
+      if (!end) waitForTick(&deadline, &jitter);
+   } while (!end);
+   
+   return NULL;
+}
+
+/**
+ * Fills in a snapshot of the game as it stands.
+ * 
+ * @param game the game in question
+ * @param snapshot the snapshot to fill in
+ */
+void takeSnapshot(GAME* game, SNAPSHOT* snapshot) {
+   PREDICTION* prediction = game->prediction;
+   
+   snapshot->tick = game->time;
+   snapshot->time = game->time;
+   snapshot->x = game->ship.lastx;
+   snapshot->y = game->ship.lasty;
+   snapshot->xMomentum = game->ship.xMomentum;
+   snapshot->yMomentum = game->ship.yMomentum;
+   snapshot->fuel = game->ship.fuel;
+   snapshot->end = end;
+   snapshot->endType = endType;
+   snapshot->meanJitter = jitter.ticks ? jitter.total / jitter.ticks : 0;
+   snapshot->worstJitter = jitter.worst;
+   snapshot->lateTicks = jitter.lateTicks;
+   
+   snapshotParticles(&snapshot->particles, game->particles);
+   
+   // Only sends the points the renderer hasn't definitely got already. It
+   // may well have had the last snapshot too, but there's no knowing that
+   // until the next publish, so that one's points may come again.
+   snapshot->predictionGeneration = prediction->generation;
+   snapshot->predictionFirst = prediction->first;
+   snapshot->predictionCount = copyPrediction(prediction,
+                                              game->seenGeneration,
+                                              game->seenEnd,
+                                              &snapshot->predictionFrom,
+                                              snapshot->predictionX,
+                                              snapshot->predictionY);
+}
+
+/**
+ * Sets up the triple buffer, with nothing in it for the renderer yet.
+ * 
+ * @param snapshots the triple buffer in question
+ */
+void initialiseSnapshots(TRIPLE_BUFFER* snapshots) {
+   snapshots->front = 0;
+   atomic_store(&snapshots->middle, 1);
+   snapshots->back = 2;
+}
+
+/**
+ * Publishes the snapshot the simulation has just filled in (the one at
+ * `back`), and takes back whichever buffer was sitting in the middle to fill in
+ * next time.
+ * 
+ * If the renderer never picked up the last one, it's simply overwritten; the
+ * simulation never has to wait for the renderer.
+ * 
+ * @param snapshots the triple buffer in question
+ * @return true if the renderer picked up the last snapshot, false if it got
+ * overwritten
+ */
+bool publishSnapshot(TRIPLE_BUFFER* snapshots) {
+   unsigned int middle = atomic_exchange_explicit(&snapshots->middle,
+                                                  snapshots->back
+                                                  | FRESH_SNAPSHOT,
+                                                  memory_order_acq_rel);
+   snapshots->back = middle & ~FRESH_SNAPSHOT;
+   return !(middle & FRESH_SNAPSHOT);
+}
+
+/**
+ * Picks up the most recently published snapshot, if it hasn't been picked up
+ * already.
+ * 
+ * The snapshot returned stays put until the next time this is called.
+ * 
+ * @param snapshots the triple buffer in question
+ * @return the snapshot, or NULL if nothing new has been published
+ */
+SNAPSHOT* acquireSnapshot(TRIPLE_BUFFER* snapshots) {
+   if (!(atomic_load_explicit(&snapshots->middle, memory_order_acquire)
+         & FRESH_SNAPSHOT))
+      return NULL;
+   
+   snapshots->front = atomic_exchange_explicit(&snapshots->middle,
+                                               snapshots->front,
+                                               memory_order_acq_rel)
+                      & ~FRESH_SNAPSHOT;
+   return &snapshots->buffers[snapshots->front];
+}
+
+/**
+ * Initialises the frame pacer.
+ * 
+ * @param pacer the pacer in question
+ */
+void initialisePacer(PACER* pacer) {
+   pacer->latency = 0;
+   pacer->queued = 0;
+   pacer->maxQueued = 0;
+   pacer->totalQueued = 0;
+   pacer->framesDrawn = 0;
+   pacer->framesDropped = 0;
+   pacer->snapshotsMissed = 0;
+   pacer->skipped = 0;
+   pacer->lowDetail = false;
+   pacer->wasLowDetail = false;
+}
+
+/**
+ * Pushes the frame out to the terminal, unless the terminal is falling behind.
+ * 
+ * Over a slow SSH link, `refresh()` can sit there for ages waiting for the
+ * terminal to drain, and everything else sits there with it. So before
+ * drawing, this has a look at how many bytes are still stuck in the
+ * terminal's output queue, and at how long the last few frames took to go
+ * out; if either is too high, the frame is dropped. Nothing is lost by this:
+ * ncurses still has the whole screen, and the next frame that does get drawn
+ * brings the terminal up to date in one go.
+ * 
+ * The HUD is also told to go into low detail when things start getting
+ * sluggish, and back out of it once they've cleared up.
+ * 
+ * @param pacer the pacer in question
+ * @return true if the frame was drawn, false if it was dropped
+ */
+bool presentFrame(PACER* pacer) {
+   // Asks the terminal how much it still has to send. If it can't say (e.g.
+   // it isn't a terminal at all), assumes it's keeping up.
+   int queued = 0;
+   if (ioctl(STDOUT_FILENO, TIOCOUTQ, &queued) == -1) queued = 0;
+   pacer->queued = queued;
+   pacer->totalQueued += queued;
+   if (queued > pacer->maxQueued) pacer->maxQueued = queued;
+   
+   // Goes into low detail at half the limits, and only comes back out again
+   // once the terminal has properly caught up, so it doesn't flicker between
+   // the two.
+   if ((queued > PACER_QUEUE_LIMIT / 2) || 
+       (pacer->latency > PACER_LATENCY_LIMIT / 2))
+      pacer->lowDetail = true;
+   else if ((queued == 0) && (pacer->latency < PACER_LATENCY_LIMIT / 8))
+      pacer->lowDetail = false;
+   
+   if (((queued > PACER_QUEUE_LIMIT) || 
+        (pacer->latency > PACER_LATENCY_LIMIT)) &&
+       (pacer->skipped < PACER_MAX_SKIP)) {
+      pacer->framesDropped++;
+      pacer->skipped++;
+      // Lets the latency estimate cool off whilst frames are being dropped,
+      // else one bad frame would stop anything being drawn ever again.
+      pacer->latency -= pacer->latency / 4;
+      return false;
+   }
+   
+   // Times how long the frame takes to actually get written, and folds it
+   // into a running average.
+   struct timespec start;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   wnoutrefresh(stdscr);
+   doupdate();
+   // Pretends to be stuck on the end of a bad connection, if asked to.
+   if (slowTerminal) {
+      struct timespec delay;
+      delay.tv_sec = SLOW_TERMINAL_DELAY / 1000000000L;
+      delay.tv_nsec = SLOW_TERMINAL_DELAY % 1000000000L;
+      nanosleep(&delay, NULL);
+   }
+   pacer->latency += (nsSince(&start) - pacer->latency) / 4;
+   
+   pacer->framesDrawn++;
+   pacer->skipped = 0;
+   return true;
+}
+
+/**
+ * Sleeps until the next tick is due, and notes how late it woke up.
+ * 
+ * Unlike sleeping for a fixed time after each tick, this doesn't let a slow
+ * tick push all the following ticks back. If things have fallen more than a
+ * whole tick behind, the schedule is restarted from now rather than trying to
+ * catch up in a mad rush.
+ * 
+ * @param deadline when the last tick was due; updated to when the next one is
+ * @param jitter the statistics to note the lateness in
+ */
+void waitForTick(struct timespec* deadline, JITTER* jitter) {
+   deadline->tv_nsec += TICK_INTERVAL;
+   if (deadline->tv_nsec >= 1000000000L) {
+      deadline->tv_sec++;
+      deadline->tv_nsec -= 1000000000L;
+   }
+   
+   // A tick that's run that far over still counts towards the statistics;
+   // it's the worst jitter there is, so leaving it out would flatter them.
+   long late = nsSince(deadline);
+   if (late > TICK_INTERVAL) {
+      jitter->lateTicks++;
+      jitter->ticks++;
+      jitter->total += late;
+      if (late > jitter->worst) jitter->worst = late;
+      clock_gettime(CLOCK_MONOTONIC, deadline);
+      return;
+   }
+   
+   clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL);
+   
+   late = nsSince(deadline);
+   jitter->ticks++;
+   jitter->total += late;
+   if (late > jitter->worst) jitter->worst = late;
+}
+
+/**
+ * Works out how long it's been since a given time.
+ * 
+ * @param start the time in question, from `CLOCK_MONOTONIC`
+ * @return the nanoseconds since then (negative if it's still to come)
+ */
+long nsSince(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (now.tv_sec - start->tv_sec) * 1000000000L
+          + (now.tv_nsec - start->tv_nsec);
+}
+
 /**
  * Displays the lovely ASCII lunar lander I nicked.
  */
@@ -26,14 +26,27 @@
  * Header file for `moonlander.c`.                                            
  */
 
+// `ppoll()` is a GNU extension.
+#define _GNU_SOURCE
 #include <stdbool.h>
 #include <ncurses.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "particles.h"
+#include "drawing.h"
+#include "prediction.h"
+#include "telemetry.h"
 
 // I almost think I should start looking into enums, rather than the
-// world's lengthiest macro lists all the time.
+// world's lengthiest macro lists all the time (see below).
 // Macros for ship jet directions.
 #define NONE 0
 #define UP 1
@@ -48,27 +61,88 @@
 #define RIGHT_DECLINE 3
 #define PLATEAU 4
 
-// Macros for the type of game end.
+// Macros for the type of game end. These go straight into the telemetry log,
+// so they're the log's own numbers.
 #define NONE 0
-#define CRASH 1
-#define LAND 2
-#define QUIT 3
+#define CRASH TELEMETRY_CRASH
+#define LAND TELEMETRY_LAND
+#define QUIT TELEMETRY_QUIT
+
+// The states the game can be in. I finally looked into enums.
+typedef enum _game_state_enum {
+   INTRO,
+   PLAYING,
+   CRASHED,
+   LANDED,
+   QUITTING
+}GAME_STATE;
+
+// What turned up whilst waiting for keys.
+typedef enum _input_state_enum {
+   INPUT_TIMEOUT,
+   INPUT_READY,
+   INPUT_LOST
+}INPUT_STATE;
 
 // Macros for setting difficulty.
 #define STARTING_FUEL 900
 #define CHANCE_OF_LANDING_PAD 3
 
-// Macros for the ship.
-#define TERMINAL_VELOCITY 0.9f
+// Macros for the game's timing. The simulation ticks every `TICK_INTERVAL`
+// nanoseconds; the renderer checks for keys and new snapshots every
+// `RENDER_INTERVAL`.
+#define TICK_INTERVAL 180000000L
+#define RENDER_INTERVAL 10000000L
+
+// Macros for the slow terminal 'debug mode', which holds up every frame by
+// `SLOW_TERMINAL_DELAY` nanoseconds to mimic a terminal on the end of a bad
+// connection.
+#define SLOW_TERMINAL_DELAY (TICK_INTERVAL * 2)
+
+// Macros for keeping the particles from hogging the frame. As well as only
+// drawing `PARTICLE_DRAW_BUDGET` of them (see `drawing.h`), drawing stops early
+// if it takes longer than `PARTICLE_TIME_BUDGET` nanoseconds.
+#define PARTICLE_TIME_BUDGET (TICK_INTERVAL / 8)
+
+// Macros for the trajectory prediction overlay. The path is predicted up to
+// `PREDICTION_HORIZON` ticks ahead.
+#define PREDICTION_HORIZON 128
+#define PREDICTION_GLYPH ('.' | COLOR_PAIR(3))
+
+// Macros for the heads-up display. Everything it shows is in the top
+// `HUD_ROWS` rows.
+#define HUD_ROWS 16
+
+// Macros for pacing the frames on slow terminals. A frame is dropped if more
+// than `PACER_QUEUE_LIMIT` bytes are still waiting to go out to the terminal,
+// or if pushing frames out has recently been taking longer than
+// `PACER_LATENCY_LIMIT` nanoseconds. The HUD drops to low detail at half of
+// either, and no more than `PACER_MAX_SKIP` frames are dropped in a row.
+#define PACER_QUEUE_LIMIT 2048
+#define PACER_LATENCY_LIMIT (TICK_INTERVAL / 4)
+#define PACER_MAX_SKIP 5
 
 // Global variables aren't the best, but I feel like I can
 // get away with a few here; it saves so very much fannying 
 // around with pointers.
 bool end = false;
 unsigned int endType = NONE;
-struct timespec_t s;
+// The seed the current landscape was generated from.
+unsigned int seed;
+// A window that's never drawn in, used just for reading keys during the game;
+// `getch()` on `stdscr` would refresh it behind the pacer's back.
+WINDOW* input;
 // Dirty cheat(s).
 bool invincible = false;
+bool slowTerminal = false;
+// Set when the terminal hangs up (or someone asks the game to stop), so that
+// it can shut down properly rather than just dropping dead and taking the
+// unwritten telemetry with it.
+volatile sig_atomic_t hungUp = 0;
+// The signal mask to wait for keys under. The hang up signals are blocked
+// the rest of the time, so one can't sneak in between checking `hungUp` and
+// going to sleep.
+sigset_t waitMask;
 
 // The bits and bobs that make up the landscape.
 typedef struct _win_landscape_struct {
@@ -100,13 +174,116 @@ typedef struct _WIN_ship_struct {
 	WIN_SHIP graphics;
 }SHIP;
 
-// I don't profess to know how `nanosleep()` works, but I nicked this
-// off of SO and it seems to do the job, even if Geany gives me an
-// 'implicit declaration' warning.
-struct timespec_t {
-    time_t tv_sec;        /* seconds */
-    long   tv_nsec;       /* nanoseconds */
-};
+// The cells the particles and the ship were drawn in last frame.
+DRAWN_CELLS particleCells, shipCells;
+
+// The frame pacer 'class'. Keeps track of how well the terminal is keeping
+// up, and how many frames have had to be dropped because of it.
+typedef struct _pacer_struct {
+   long latency;
+   int queued, maxQueued;
+   unsigned long long totalQueued;
+   unsigned int framesDrawn, framesDropped, snapshotsMissed;
+   unsigned int skipped;
+   bool lowDetail, wasLowDetail;
+}PACER;
+PACER pacer;
+
+// How far along each of its rows the heads-up display has written, so that
+// the rows it stops showing in low detail can be blanked without taking the
+// landscape next to them as well.
+int hudEnds[HUD_ROWS];
+
+// How far off schedule the simulation's ticks have been. Only the simulation
+// thread writes to this whilst a game is going.
+typedef struct _jitter_struct {
+   unsigned long ticks;
+   long long total;
+   long worst;
+   unsigned int lateTicks;
+}JITTER;
+JITTER jitter;
+
+// Everything the renderer needs to draw one tick of the game. Once it's been
+// published, it's never changed.
+typedef struct _snapshot_struct {
+   unsigned long tick;
+   unsigned int time;
+   int x, y;
+   float xMomentum, yMomentum;
+   int fuel;
+   bool end;
+   unsigned int endType;
+   long meanJitter, worstJitter;
+   unsigned int lateTicks;
+   PARTICLE_FRAME particles;
+   // Only the points of the predicted path that the renderer might not have
+   // yet; see `copyPrediction()`.
+   unsigned long predictionGeneration, predictionFirst, predictionFrom;
+   size_t predictionCount;
+   int predictionX[PREDICTION_HORIZON], predictionY[PREDICTION_HORIZON];
+}SNAPSHOT;
+
+// The predicted path as it's been drawn. The renderer keeps its own copy of
+// the points on screen, numbered the same as in the `PREDICTION`, so that
+// each frame only has to rub out the points that have been dropped and draw
+// the ones that have been added. Several points can land in the same cell,
+// so `counts` keeps track of how many there are in each, and a cell is only
+// rubbed out once the last of them is gone.
+typedef struct _trail_struct {
+   bool drawn;
+   unsigned long generation, first, end;
+   int x[PREDICTION_HORIZON], y[PREDICTION_HORIZON];
+   int cols, lines;
+   unsigned short* counts;
+}TRAIL;
+TRAIL trail;
+
+// Passes snapshots from the simulation to the renderer without either ever
+// waiting on the other. The simulation fills in `back`, then swaps it with
+// `middle`; the renderer swaps `front` with `middle` whenever there's
+// something new there. `FRESH_SNAPSHOT` is set in `middle` when it holds a
+// snapshot the renderer hasn't seen yet.
+#define FRESH_SNAPSHOT 4U
+typedef struct _triple_buffer_struct {
+   SNAPSHOT buffers[3];
+   atomic_uint middle;
+   unsigned int back, front;
+}TRIPLE_BUFFER;
+
+// Everything the simulation thread needs to run a game. The keys come in
+// through the atomics; everything else belongs to the simulation until the
+// game is over.
+typedef struct _game_struct {
+   SHIP ship;
+   PARTICLES* particles;
+   PREDICTION* prediction;
+   size_t lASize, sASize;
+   unsigned int* landscapeArray;
+   unsigned int* safeArray;
+   unsigned char* terrain;
+   unsigned int time;
+   unsigned int inputs[TELEMETRY_INPUTS];
+   int cols, lines;
+   atomic_uint jetRequest;
+   atomic_bool quitRequest, showPrediction;
+   TRIPLE_BUFFER* snapshots;
+   // How much of the predicted path went out in the last snapshot, and how
+   // much the renderer is known to have picked up.
+   unsigned long sentGeneration, sentEnd;
+   unsigned long seenGeneration, seenEnd;
+}GAME;
+
+// Game state functions.
+GAME_STATE runIntro();
+GAME_STATE playGame(GAME* game, TELEMETRY* telemetry);
+GAME_STATE runCrashed(GAME* game);
+GAME_STATE runLanded(GAME* game);
+INPUT_STATE waitForInput(long timeout);
+
+// Signal handling functions.
+void initialiseSignals();
+void handleHangUp(int signal);
 
 // Initialisation functions.
 void initialisencurses();
@@ -122,6 +299,32 @@ void applyJet(SHIP* ship, unsigned int dir);
 void applyGravity(SHIP* ship);
 void applyFriction(SHIP* ship);
 
+// Particle functions.
+void emitJetExhaust(PARTICLES* particles, SHIP* ship, unsigned int dir);
+
+// Simulation thread functions.
+void* simulate(void* game);
+void takeSnapshot(GAME* game, SNAPSHOT* snapshot);
+void waitForTick(struct timespec* deadline, JITTER* jitter);
+
+// Snapshot passing functions.
+void initialiseSnapshots(TRIPLE_BUFFER* snapshots);
+bool publishSnapshot(TRIPLE_BUFFER* snapshots);
+SNAPSHOT* acquireSnapshot(TRIPLE_BUFFER* snapshots);
+
+// Drawing functions. The particles and cells are drawn by `drawing.c`.
+void resetTrail(TRAIL* trail, unsigned short counts[], int cols, int lines);
+void restoreTrailCell(TRAIL* trail, int x, int y);
+void drawPrediction(SNAPSHOT* snapshot);
+void noteHudRow(int row);
+void hideHudRow(int row);
+void drawFrame(SNAPSHOT* snapshot, unsigned int safeArray[]);
+
+// Frame pacing functions.
+void initialisePacer(PACER* pacer);
+bool presentFrame(PACER* pacer);
+long nsSince(struct timespec* start);
+
 // Ship movement function. Includes collision detection.
 void moveShip(SHIP* ship, size_t lASize, unsigned int landscapeArray[],
                           size_t sASize, unsigned int safeArray[]);
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Times how long `updateParticles()` takes with a full pool of 10,000-odd
+ * particles on the go, just to prove that a big explosion can't eat the tick.
+ * Then times what each frame does with them: `snapshotParticles()` copying
+ * them out, and `eraseCells()` and `drawParticles()` putting them on the
+ * screen, which is what `PARTICLE_DRAW_BUDGET` is there to keep in check. The
+ * screen is a real ncurses one, just sent to `/dev/null` rather than a
+ * terminal, and the drawing isn't given a time budget, so the whole lot is
+ * always drawn.
+ *
+ * The update's first pass only gets vectorised at `-O3` (GCC won't at
+ * `-O2`), hence building it that way, same as the game. Build and run with:
+ *
+ *    gcc -std=gnu99 -O3 particlebench.c particles.c drawing.c \
+ *        -o particlebench -lncurses -lm
+ *    ./particlebench
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "particles.h"
+#include "drawing.h"
+
+// Macros for the benchmark. The screen is as big as the world the particles
+// move about in.
+#define BENCH_PARTICLES 10000
+#define BENCH_PASSES 10000
+#define BENCH_SIZE 1000
+#define BENCH_SIZE_STRING "1000"
+
+/**
+ * Gives the time since `start`, in nanoseconds.
+ *
+ * @param start the time in question
+ * @return the elapsed nanoseconds
+ */
+static long long elapsed(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (now.tv_sec - start->tv_sec) * 1000000000LL
+          + (now.tv_nsec - start->tv_nsec);
+}
+
+/**
+ * Tops the pool back up to `BENCH_PARTICLES` live particles.
+ *
+ * @param particles the pool in question
+ */
+static void topUp(PARTICLES* particles) {
+   while (particles->count < BENCH_PARTICLES) {
+      if ((particles->count & 1) == 0)
+         emitDebris(particles, 500.0f, 500.0f, 0.3f, 0.6f);
+      else
+         emitExhaust(particles, 500.0f, 500.0f, 0.0f, 1.0f);
+   }
+}
+
+/**
+ * The main function of the benchmark.
+ *
+ * @return 0 on success
+ */
+int main() {
+   // Far too big for the stack, and the game doesn't `malloc()` it either.
+   static PARTICLES particles;
+   static PARTICLE_FRAME frame;
+   static DRAWN_CELLS cells;
+   struct timespec start;
+   long long total = 0, worst = 0;
+   long long snapshotTotal = 0, snapshotWorst = 0;
+   long long drawTotal = 0, drawWorst = 0;
+   size_t drawn = 0;
+
+   // An ncurses screen that goes nowhere, as big as the world.
+   FILE* nowhere = fopen("/dev/null", "w");
+   if (nowhere == NULL) return 1;
+   setenv("LINES", BENCH_SIZE_STRING, 1);
+   setenv("COLUMNS", BENCH_SIZE_STRING, 1);
+   if (newterm("vt100", nowhere, stdin) == NULL) return 1;
+   start_color();
+
+   srand(150);
+   initialiseParticles(&particles);
+   cells.count = 0;
+
+   for (int i = 0; i < BENCH_PASSES; i++) {
+      // The topping up isn't timed; it stands in for however many particles
+      // the game happens to emit that tick.
+      topUp(&particles);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      updateParticles(&particles, BENCH_SIZE, BENCH_SIZE);
+      long long pass = elapsed(&start);
+      total += pass;
+      if (pass > worst) worst = pass;
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      snapshotParticles(&frame, &particles);
+      pass = elapsed(&start);
+      snapshotTotal += pass;
+      if (pass > snapshotWorst) snapshotWorst = pass;
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      eraseCells(&cells);
+      drawn += drawParticles(&frame, &cells, LONG_MAX);
+      pass = elapsed(&start);
+      drawTotal += pass;
+      if (pass > drawWorst) drawWorst = pass;
+   }
+   endwin();
+
+   printf("%d passes over %d particles\n", BENCH_PASSES, BENCH_PARTICLES);
+   printf("update:   %lld ns/pass mean (%.2f ns/particle), "
+          "%lld ns/pass worst\n", total / BENCH_PASSES,
+          (double)total / BENCH_PASSES / BENCH_PARTICLES, worst);
+   printf("snapshot: %lld ns/pass mean, %lld ns/pass worst "
+          "(%d particles copied)\n", snapshotTotal / BENCH_PASSES,
+          snapshotWorst, PARTICLE_DRAW_BUDGET);
+   printf("draw:     %lld ns/pass mean, %lld ns/pass worst "
+          "(%.0f cells drawn)\n", drawTotal / BENCH_PASSES, drawWorst,
+          (double)drawn / BENCH_PASSES);
+
+   return 0;
+}
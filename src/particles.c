@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * The jet exhaust and crash debris particles.
+ *
+ * All of the particles live in one fixed-size pool that is set up before the
+ * game starts, so nothing gets `malloc()`ed whilst the player is playing.
+ * Drawing them is left to `drawing.c`, which knows about ncurses.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "particles.h"
+
+/**
+ * Gives a random float between -`spread` and `spread`.
+ *
+ * @param spread the maximum distance from zero
+ * @return the random float
+ */
+static float jitter(float spread) {
+   return spread * (((float)rand() / (float)RAND_MAX) * 2.0f - 1.0f);
+}
+
+/**
+ * Adds a single particle to the end of the pool.
+ *
+ * @param particles the pool in question
+ * @param kind `EXHAUST` or `DEBRIS`
+ * @param x the x-coord to emit it at
+ * @param y the y-coord to emit it at
+ * @param xMomentum its starting x-momentum
+ * @param yMomentum its starting y-momentum
+ * @param weight how much gravity pulls on it each tick
+ * @param life how many ticks it lasts
+ * @return true if there was room for it, false if not
+ */
+static bool emitParticle(PARTICLES* particles, unsigned char kind,
+                        float x, float y, float xMomentum, float yMomentum,
+                        float weight, int life) {
+   size_t i = particles->count;
+
+   if (i >= MAX_PARTICLES) return false;
+
+   particles->x[i] = x;
+   particles->y[i] = y;
+   particles->xMomentum[i] = xMomentum;
+   particles->yMomentum[i] = yMomentum;
+   particles->weight[i] = weight;
+   particles->life[i] = life;
+   particles->kind[i] = kind;
+   particles->count++;
+
+   return true;
+}
+
+/**
+ * Empties the particle pool.
+ *
+ * @param particles the pool in question
+ */
+void initialiseParticles(PARTICLES* particles) {
+   particles->count = 0;
+}
+
+/**
+ * Emits a puff of exhaust from the ship's jet.
+ *
+ * @param particles the pool in question
+ * @param x the x-coord of the ship
+ * @param y the y-coord of the ship
+ * @param xDir the x-component of the direction the exhaust should travel in
+ * (i.e. the opposite direction to the thrust)
+ * @param yDir the y-component of the same
+ * @return the number of particles actually emitted
+ */
+size_t emitExhaust(PARTICLES* particles, float x, float y,
+                                         float xDir, float yDir) {
+   size_t emitted = 0;
+
+   for (int i = 0; i < EXHAUST_PER_TICK; i++) {
+      // Fans the plume out a bit perpendicular to the direction of travel.
+      float xM = xDir + ((xDir == 0.0f) ? jitter(0.6f) : jitter(0.2f));
+      float yM = yDir + ((yDir == 0.0f) ? jitter(0.6f) : jitter(0.2f));
+
+      emitted += emitParticle(particles, EXHAUST, x + xDir, y + yDir, xM, yM,
+                              0.0f, EXHAUST_LIFE + (rand() % 2));
+   }
+
+   return emitted;
+}
+
+/**
+ * Blows the ship into bits.
+ *
+ * @param particles the pool in question
+ * @param x the x-coord of the crash
+ * @param y the y-coord of the crash
+ * @param xMomentum the ship's x-momentum at the time of the crash
+ * @param yMomentum the ship's y-momentum at the time of the crash
+ * @return the number of particles actually emitted
+ */
+size_t emitDebris(PARTICLES* particles, float x, float y,
+                                        float xMomentum, float yMomentum) {
+   size_t emitted = 0;
+
+   for (int i = 0; i < DEBRIS_PER_CRASH; i++) {
+      // The debris inherits a little of the ship's momentum, and always
+      // kicks upwards off of whatever it hit.
+      float xM = (xMomentum * 0.3f) + jitter(1.2f);
+      float yM = -(yMomentum * 0.3f) - 0.4f
+                 - ((float)rand() / (float)RAND_MAX) * 0.8f;
+
+      emitted += emitParticle(particles, DEBRIS, x, y - 1.0f, xM, yM,
+                              DEBRIS_GRAVITY, DEBRIS_LIFE + (rand() % 8));
+   }
+
+   return emitted;
+}
+
+/**
+ * Moves every particle on by one tick, and removes the ones that have
+ * burnt out or left the screen.
+ *
+ * This is done in two passes: the first just does the arithmetic on each
+ * field, without any branching, so that it can be vectorised (which GCC only
+ * does at `-O3`); the second compacts the dead particles out of the pool by
+ * swapping the last live particle into their slot.
+ *
+ * @param particles the pool in question
+ * @param width the width of the screen
+ * @param height the height of the screen
+ */
+void updateParticles(PARTICLES* particles, int width, int height) {
+   size_t n = particles->count;
+   float* restrict x = particles->x;
+   float* restrict y = particles->y;
+   float* restrict xM = particles->xMomentum;
+   float* restrict yM = particles->yMomentum;
+   float* restrict weight = particles->weight;
+   int* restrict life = particles->life;
+
+   for (size_t i = 0; i < n; i++) {
+      x[i] += xM[i];
+      y[i] += yM[i];
+      yM[i] += weight[i];
+      life[i]--;
+   }
+
+   for (size_t i = 0; i < n;) {
+      if ((life[i] <= 0) || (x[i] < 0.0f) || (x[i] >= (float)width)
+                         || (y[i] < 0.0f) || (y[i] >= (float)height)) {
+         n--;
+         x[i] = x[n]; y[i] = y[n];
+         xM[i] = xM[n]; yM[i] = yM[n];
+         weight[i] = weight[n];
+         life[i] = life[n];
+         particles->kind[i] = particles->kind[n];
+      } else i++;
+   }
+
+   particles->count = n;
+}
@@ -0,0 +1,73 @@
+#ifndef PARTICLES_H_
+#define PARTICLES_H_
+
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Header file for `particles.c`.
+ *
+ * Deliberately knows nothing about ncurses or the `SHIP`, so that it can be
+ * linked into `particlebench.c` without dragging the whole game along.
+ */
+
+#include <stddef.h>
+
+// Macros for sizing the particle pool. The pool is allocated once, up front,
+// and never grows; if it's full, new particles are simply not emitted.
+#define MAX_PARTICLES 10240
+
+// Macros for the kinds of particle.
+#define EXHAUST 0
+#define DEBRIS 1
+
+// Macros for the particle behaviour.
+#define EXHAUST_PER_TICK 3
+#define EXHAUST_LIFE 4
+#define DEBRIS_PER_CRASH 48
+#define DEBRIS_LIFE 24
+#define DEBRIS_GRAVITY 0.05f
+
+// The particle pool 'class'. Everything is stored as a structure of arrays
+// rather than an array of structures, so that the update pass walks each
+// field contiguously and the compiler can vectorise it.
+typedef struct _particle_pool_struct {
+   size_t count;
+   float x[MAX_PARTICLES], y[MAX_PARTICLES];
+   float xMomentum[MAX_PARTICLES], yMomentum[MAX_PARTICLES];
+   float weight[MAX_PARTICLES];
+   int life[MAX_PARTICLES];
+   unsigned char kind[MAX_PARTICLES];
+}PARTICLES;
+
+// Initialisation function.
+void initialiseParticles(PARTICLES* particles);
+
+// Emission functions.
+size_t emitExhaust(PARTICLES* particles, float x, float y,
+                                         float xDir, float yDir);
+size_t emitDebris(PARTICLES* particles, float x, float y,
+                                        float xMomentum, float yMomentum);
+
+// Simulation function.
+void updateParticles(PARTICLES* particles, int width, int height);
+
+#endif /* PARTICLES_H_ */
@@ -0,0 +1,234 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Works out where the ship is heading if it just coasts.
+ *
+ * The prediction has to match what the game actually does to the last bit,
+ * so the gravity and friction the game applies to the ship live here too,
+ * and `moonlander.c` calls them rather than keeping a copy of its own.
+ * Drawing the path is left to `moonlander.c`.
+ */
+
+#include <math.h>
+#include "prediction.h"
+
+// A (hypothetical) ship with its jets off; just the bits of it the physics
+// cares about.
+typedef struct _ghost_struct {
+   float xF, yF;
+   float xMomentum, yMomentum;
+}GHOST;
+
+/**
+ * Applies the relentless march of gravity to some up/down momentum.
+ *
+ * @param yMomentum the momentum in question
+ * @return the momentum after a tick of gravity
+ */
+float applyGravityTo(float yMomentum) {
+   if (yMomentum <= TERMINAL_VELOCITY) yMomentum += GRAVITY;
+   return yMomentum;
+}
+
+/**
+ * Applies the equally relentless force of friction to some momentum.
+ *
+ * @param momentum the momentum in question
+ * @return the momentum after a tick of friction
+ */
+float applyFrictionTo(float momentum) {
+   if (momentum > 0.0f)
+      momentum -= FRICTION;
+   else
+      momentum += FRICTION;
+   return momentum;
+}
+
+/**
+ * Moves a ghost on by a tick.
+ *
+ * This has to do exactly what the game loop and `moveShip()` do, in exactly
+ * the same order, so that the prediction matches up with reality to the last
+ * bit.
+ *
+ * @param ghost the ghost in question
+ */
+static void coastShip(GHOST* ghost) {
+   ghost->yMomentum = applyGravityTo(ghost->yMomentum);
+   ghost->yMomentum = applyFrictionTo(ghost->yMomentum);
+   ghost->xMomentum = applyFrictionTo(ghost->xMomentum);
+   ghost->xF += ghost->xMomentum;
+   ghost->yF += ghost->yMomentum;
+}
+
+/**
+ * Carries the prediction on from its last point until it either hits the
+ * landscape or reaches the horizon.
+ *
+ * @param prediction the prediction in question
+ * @param ghost where to carry on from
+ * @param terrain the map of which cells hold the landscape
+ */
+static void extendPrediction(PREDICTION* prediction, GHOST* ghost,
+                             const unsigned char terrain[]) {
+   int cols = prediction->cols;
+   int lines = prediction->lines;
+   size_t horizon = prediction->horizon;
+
+   while (!prediction->hit && (prediction->length < horizon)) {
+      coastShip(ghost);
+
+      int x = round(ghost->xF);
+      int y = round(ghost->yF);
+
+      // Stops dead at the first bit of landscape. Anything off the sides or
+      // the bottom of the screen is never coming back, so that's a stop too;
+      // off the top is fine, it'll come back down eventually.
+      if ((x < 0) || (x >= cols) || (y >= lines) ||
+          ((y >= 0) && terrain[(size_t)y * cols + x])) {
+         prediction->hit = true;
+         break;
+      }
+
+      size_t i = (prediction->first + prediction->length) % horizon;
+      prediction->xF[i] = ghost->xF;
+      prediction->yF[i] = ghost->yF;
+      prediction->xMomentum[i] = ghost->xMomentum;
+      prediction->yMomentum[i] = ghost->yMomentum;
+      prediction->x[i] = x;
+      prediction->y[i] = y;
+      prediction->length++;
+   }
+}
+
+/**
+ * Forgets the whole prediction.
+ *
+ * @param prediction the prediction in question
+ * @param horizon how many ticks ahead to predict, up to
+ * `MAX_PREDICTION_HORIZON`
+ * @param cols the width of the game world
+ * @param lines the height of the game world
+ */
+void resetPrediction(PREDICTION* prediction, size_t horizon, int cols,
+                     int lines) {
+   if (horizon > MAX_PREDICTION_HORIZON) horizon = MAX_PREDICTION_HORIZON;
+   prediction->horizon = horizon;
+   prediction->cols = cols;
+   prediction->lines = lines;
+   prediction->generation++;
+   prediction->first = 0;
+   prediction->length = 0;
+   prediction->hit = false;
+}
+
+/**
+ * Brings the predicted path of the ship up to date after a tick.
+ *
+ * Working the whole path out afresh every tick would be a waste when the ship
+ * is just coasting: the physics only depends on where the ship is and how
+ * fast it's going, so if the jets were off, the ship has ended up exactly
+ * where the first predicted point said it would, and the rest of the path
+ * still holds. In that case the first point is just dropped and one more is
+ * added onto the end. Only when the jets have been used (or the ship somehow
+ * isn't where it was meant to be) is the path worked out from scratch.
+ *
+ * @param prediction the prediction in question
+ * @param xF the ship's x-coord
+ * @param yF the ship's y-coord
+ * @param xMomentum the ship's left/right momentum
+ * @param yMomentum the ship's up/down momentum
+ * @param coasted true if the jets were off this tick
+ * @param terrain the map of which cells hold the landscape
+ */
+void updatePrediction(PREDICTION* prediction, float xF, float yF,
+                      float xMomentum, float yMomentum, bool coasted,
+                      const unsigned char terrain[]) {
+   size_t head = prediction->first % prediction->horizon;
+   size_t horizon = prediction->horizon;
+   GHOST ghost;
+
+   if (coasted && (prediction->length > 0) &&
+       (prediction->xF[head] == xF) && (prediction->yF[head] == yF) &&
+       (prediction->xMomentum[head] == xMomentum) &&
+       (prediction->yMomentum[head] == yMomentum)) {
+      prediction->first++;
+      prediction->length--;
+
+      // Carries on from the last point, if there's still one to carry on
+      // from.
+      if (prediction->length > 0) {
+         size_t last = (prediction->first + prediction->length - 1) % horizon;
+         ghost.xF = prediction->xF[last];
+         ghost.yF = prediction->yF[last];
+         ghost.xMomentum = prediction->xMomentum[last];
+         ghost.yMomentum = prediction->yMomentum[last];
+         extendPrediction(prediction, &ghost, terrain);
+         return;
+      }
+   }
+
+   // Otherwise starts again from wherever the ship is now.
+   prediction->generation++;
+   prediction->first = 0;
+   prediction->length = 0;
+   prediction->hit = false;
+   ghost.xF = xF;
+   ghost.yF = yF;
+   ghost.xMomentum = xMomentum;
+   ghost.yMomentum = yMomentum;
+   extendPrediction(prediction, &ghost, terrain);
+}
+
+/**
+ * Copies out whichever points of the path someone hasn't already got.
+ *
+ * If they've got points up to (but not including) `end` from the same
+ * generation of the path, only the points from there on are copied, which
+ * when the ship's coasting is usually just one or two. Otherwise the whole
+ * path is.
+ *
+ * @param prediction the prediction in question
+ * @param generation the generation of the path they've got
+ * @param end the number of the point after the last one they've got
+ * @param from filled in with the number of the first point copied
+ * @param x where to copy the points' x-coords
+ * @param y where to copy the points' y-coords
+ * @return how many points were copied
+ */
+size_t copyPrediction(const PREDICTION* prediction, unsigned long generation,
+                      unsigned long end, unsigned long* from, int x[], int y[]) {
+   unsigned long start = prediction->first;
+   unsigned long last = prediction->first + prediction->length;
+   size_t horizon = prediction->horizon;
+
+   if ((generation == prediction->generation) && (end > start)) start = end;
+   if (start > last) start = last;
+
+   for (unsigned long i = start; i < last; i++) {
+      x[i - start] = prediction->x[i % horizon];
+      y[i - start] = prediction->y[i % horizon];
+   }
+
+   *from = start;
+   return last - start;
+}
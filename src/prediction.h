@@ -0,0 +1,78 @@
+#ifndef PREDICTION_H_
+#define PREDICTION_H_
+
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Header file for `prediction.c`.
+ *
+ * Like `particles.h`, this deliberately knows nothing about ncurses or the
+ * `SHIP`, so that it can be linked into `predictionbench.c` on its own.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Macros for the ship's physics. These live here rather than in
+// `moonlander.h` so that the prediction and the game share the one copy.
+#define TERMINAL_VELOCITY 0.9f
+#define GRAVITY 0.05f
+#define FRICTION 0.025f
+
+// Macros for sizing the prediction. The ring is allocated at the longest
+// horizon it'll ever be asked for; how far ahead it actually looks is set
+// when it's reset.
+#define MAX_PREDICTION_HORIZON 4096
+
+// The trajectory prediction 'class'. The predicted points are kept in a ring,
+// so that the oldest can be dropped off the front and a new one added to the
+// back without shuffling everything else along. Every point gets a number,
+// counting up from `first`, that it keeps until it's dropped; whenever the
+// path is worked out from scratch, the numbering starts again with a new
+// `generation`. Between them, they let whoever's drawing the path ask for
+// just the points they haven't seen.
+typedef struct _prediction_struct {
+   size_t horizon;
+   unsigned long generation;
+   unsigned long first;
+   size_t length;
+   bool hit;
+   int cols, lines;
+   float xF[MAX_PREDICTION_HORIZON], yF[MAX_PREDICTION_HORIZON];
+   float xMomentum[MAX_PREDICTION_HORIZON], yMomentum[MAX_PREDICTION_HORIZON];
+   int x[MAX_PREDICTION_HORIZON], y[MAX_PREDICTION_HORIZON];
+}PREDICTION;
+
+// Physics functions.
+float applyGravityTo(float yMomentum);
+float applyFrictionTo(float momentum);
+
+// Prediction functions.
+void resetPrediction(PREDICTION* prediction, size_t horizon, int cols,
+                     int lines);
+void updatePrediction(PREDICTION* prediction, float xF, float yF,
+                      float xMomentum, float yMomentum, bool coasted,
+                      const unsigned char terrain[]);
+size_t copyPrediction(const PREDICTION* prediction, unsigned long generation,
+                      unsigned long end, unsigned long* from, int x[], int y[]);
+
+#endif /* PREDICTION_H_ */
@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Times how long `updatePrediction()` takes, both when the ship's coasting
+ * (and the old path gets reused, with only the new points copied out for the
+ * renderer) and when the path has to be worked out from scratch, at the
+ * game's own horizon and at the longest one the prediction can take, over a
+ * world far wider and taller than any terminal.
+ *
+ * Build and run with:
+ *
+ *    gcc -std=gnu11 -O3 predictionbench.c prediction.c -o predictionbench -lm
+ *    ./predictionbench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "prediction.h"
+
+// Macros for the benchmark. The world is tall enough that the path can run
+// the whole horizon without hitting the ground, all the way through the
+// coasting passes.
+#define BENCH_PASSES 10000
+#define BENCH_COLS 1000
+#define BENCH_LINES (MAX_PREDICTION_HORIZON + BENCH_PASSES + 16)
+
+/**
+ * Gives the time since `start`, in nanoseconds.
+ *
+ * @param start the time in question
+ * @return the elapsed nanoseconds
+ */
+static long long elapsed(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (now.tv_sec - start->tv_sec) * 1000000000LL
+          + (now.tv_nsec - start->tv_nsec);
+}
+
+/**
+ * Runs both halves of the benchmark at one horizon.
+ *
+ * @param prediction the prediction to run it on
+ * @param horizon how far ahead to predict
+ * @param terrain the map of which cells hold the landscape
+ */
+static void bench(PREDICTION* prediction, size_t horizon,
+                  const unsigned char terrain[]) {
+   struct timespec start;
+   long long total, worst;
+   size_t points, reused, sent;
+   // Somewhere to copy the points out to, as the game does for the renderer.
+   static int x[MAX_PREDICTION_HORIZON], y[MAX_PREDICTION_HORIZON];
+   unsigned long from;
+   float xF, yF, xMomentum, yMomentum;
+
+   printf("horizon %zu, world %dx%d, %d passes\n", horizon, BENCH_COLS,
+          BENCH_LINES, BENCH_PASSES);
+
+   // Works the path out from scratch every pass, as if the jets were
+   // firing every tick.
+   resetPrediction(prediction, horizon, BENCH_COLS, BENCH_LINES);
+   total = 0; worst = 0; points = 0;
+   for (int i = 0; i < BENCH_PASSES; i++) {
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      updatePrediction(prediction, BENCH_COLS / 2, 2.0f, 0.3f, -0.5f, false,
+                       terrain);
+      long long pass = elapsed(&start);
+
+      total += pass;
+      points += prediction->length;
+      if (pass > worst) worst = pass;
+   }
+   printf("recompute: %lld ns/pass mean, %lld ns/pass worst, "
+          "%.2f ns/point (%zu points)\n", total / BENCH_PASSES, worst,
+          (double)total / points, points / BENCH_PASSES);
+
+   // Lets the ship coast, so that every pass should just drop the first
+   // point and add one on the end. The ship is moved on exactly as the game
+   // would move it.
+   xF = BENCH_COLS / 2; yF = 2.0f; xMomentum = 0.3f; yMomentum = -0.5f;
+   resetPrediction(prediction, horizon, BENCH_COLS, BENCH_LINES);
+   updatePrediction(prediction, xF, yF, xMomentum, yMomentum, false, terrain);
+   total = 0; worst = 0; reused = 0; sent = 0;
+   for (int i = 0; i < BENCH_PASSES; i++) {
+      unsigned long generation = prediction->generation;
+      unsigned long first = prediction->first;
+      unsigned long end = first + prediction->length;
+      yMomentum = applyFrictionTo(applyGravityTo(yMomentum));
+      xMomentum = applyFrictionTo(xMomentum);
+      xF += xMomentum;
+      yF += yMomentum;
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      updatePrediction(prediction, xF, yF, xMomentum, yMomentum, true,
+                       terrain);
+      // Only what's new since the last pass needs sending.
+      sent += copyPrediction(prediction, generation, end, &from, x, y);
+      long long pass = elapsed(&start);
+
+      total += pass;
+      if (pass > worst) worst = pass;
+      if ((prediction->generation == generation) &&
+          (prediction->first == first + 1)) reused++;
+   }
+   printf("coasting:  %lld ns/pass mean, %lld ns/pass worst, "
+          "%zu/%d passes reused the path, %.2f points/pass sent\n\n",
+          total / BENCH_PASSES, worst, reused, BENCH_PASSES,
+          (double)sent / BENCH_PASSES);
+}
+
+/**
+ * The main function of the benchmark.
+ *
+ * @return 0 on success, 1 if the world couldn't be made
+ */
+int main() {
+   // Far too big for the stack, and the game doesn't `malloc()` it either.
+   static PREDICTION prediction;
+
+   // Nothing but a floor along the bottom.
+   unsigned char* terrain = calloc((size_t)BENCH_COLS * BENCH_LINES, 1);
+   if (terrain == NULL) return 1;
+   for (size_t x = 0; x < BENCH_COLS; x++)
+      terrain[(size_t)(BENCH_LINES - 1) * BENCH_COLS + x] = 1;
+
+   // The game's own horizon (see `PREDICTION_HORIZON` in `moonlander.h`),
+   // and the longest there is.
+   bench(&prediction, 128, terrain);
+   bench(&prediction, MAX_PREDICTION_HORIZON, terrain);
+
+   free(terrain);
+   return 0;
+}
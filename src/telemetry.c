@@ -0,0 +1,156 @@
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Writes the telemetry log. See `telemetry.h` for what the log looks like.
+ *
+ * Games are saved up in memory and written out a batch at a time, with one
+ * `write()` and one `fsync()` per batch rather than per game. The file is only
+ * ever appended to, and a whole block goes out in one `write()`, so several
+ * games running at once can share the same log.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "telemetry.h"
+
+/**
+ * Copies a column into the block being built, padding it out to 8 bytes.
+ *
+ * @param dest where in the block the column goes
+ * @param src the column in question
+ * @param count how many values are in it
+ * @param width how wide each value is
+ * @return where the next column goes
+ */
+static unsigned char* packColumn(unsigned char* dest, const void* src,
+                                 size_t count, size_t width) {
+   size_t size = TELEMETRY_COLUMN(count, width);
+
+   memcpy(dest, src, count * width);
+   memset(dest + (count * width), 0, size - (count * width));
+
+   return dest + size;
+}
+
+/**
+ * Opens the telemetry log, creating it if need be.
+ *
+ * If the log can't be opened, games just don't get logged; it's not worth
+ * stopping anyone playing over.
+ *
+ * @param telemetry the log in question
+ * @param path where the log lives
+ * @return true if the log was opened, false if not
+ */
+bool openTelemetry(TELEMETRY* telemetry, const char* path) {
+   telemetry->count = 0;
+   telemetry->fd = open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+
+   return telemetry->fd != -1;
+}
+
+/**
+ * Adds a game to the log.
+ *
+ * The game is only held in memory until there's a full batch, at which point
+ * the whole lot is written out.
+ *
+ * @param telemetry the log in question
+ * @param record the game in question
+ * @return false if a batch needed writing and couldn't be, true otherwise
+ */
+bool logGame(TELEMETRY* telemetry, TELEMETRY_RECORD* record) {
+   size_t i = telemetry->count++;
+
+   telemetry->seed[i] = record->seed;
+   telemetry->ticks[i] = record->ticks;
+   telemetry->fuelUsed[i] = record->fuelUsed;
+   telemetry->xMomentum[i] = record->xMomentum;
+   telemetry->yMomentum[i] = record->yMomentum;
+   for (int j = 0; j < TELEMETRY_INPUTS; j++)
+      telemetry->inputs[j][i] = record->inputs[j];
+   telemetry->endType[i] = record->endType;
+
+   if (telemetry->count == TELEMETRY_BATCH)
+      return flushTelemetry(telemetry);
+   return true;
+}
+
+/**
+ * Writes out whatever games are being held as a single block, and makes sure
+ * it's actually on the disk.
+ *
+ * @param telemetry the log in question
+ * @return true if the block was written (or there was nothing to write),
+ * false if not
+ */
+bool flushTelemetry(TELEMETRY* telemetry) {
+   size_t n = telemetry->count;
+   TELEMETRY_HEADER header;
+   unsigned char* p = telemetry->block;
+
+   if (n == 0) return true;
+   // Whatever happens, the batch is done with; there's no sense in trying to
+   // write the same games twice.
+   telemetry->count = 0;
+   if (telemetry->fd == -1) return false;
+
+   header.magic = TELEMETRY_MAGIC;
+   header.version = TELEMETRY_VERSION;
+   header.inputs = TELEMETRY_INPUTS;
+   header.count = n;
+   header.reserved = 0;
+   memcpy(p, &header, sizeof(header));
+   p += sizeof(header);
+
+   // The order these go in is the file format; see `telemetry.h`.
+   p = packColumn(p, telemetry->seed, n, sizeof(uint64_t));
+   p = packColumn(p, telemetry->ticks, n, sizeof(uint32_t));
+   p = packColumn(p, telemetry->fuelUsed, n, sizeof(uint32_t));
+   p = packColumn(p, telemetry->xMomentum, n, sizeof(float));
+   p = packColumn(p, telemetry->yMomentum, n, sizeof(float));
+   for (int j = 0; j < TELEMETRY_INPUTS; j++)
+      p = packColumn(p, telemetry->inputs[j], n, sizeof(uint32_t));
+   p = packColumn(p, telemetry->endType, n, sizeof(uint8_t));
+
+   size_t size = p - telemetry->block;
+   ssize_t written;
+   do {
+      written = write(telemetry->fd, telemetry->block, size);
+   } while ((written == -1) && (errno == EINTR));
+
+   if (written != (ssize_t)size) return false;
+   return fsync(telemetry->fd) == 0;
+}
+
+/**
+ * Writes out any games still being held, and closes the log.
+ *
+ * @param telemetry the log in question
+ */
+void closeTelemetry(TELEMETRY* telemetry) {
+   flushTelemetry(telemetry);
+   if (telemetry->fd != -1) close(telemetry->fd);
+   telemetry->fd = -1;
+}
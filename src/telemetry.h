@@ -0,0 +1,109 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/**
+ * @file
+ * @author  Ben Goldsworthy (rumps) <me+moonlander@bengoldworthy.net>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * Header file for `telemetry.c`, and the description of the telemetry log
+ * that `analyser.c` reads back.
+ *
+ * The log is nothing but blocks, one after the other, each holding up to
+ * `TELEMETRY_BATCH` games. Every block starts with a `TELEMETRY_HEADER`, and
+ * then has one column per field, in this order:
+ *
+ * - `seed`      `uint64_t` x count
+ * - `ticks`     `uint32_t` x count
+ * - `fuelUsed`  `uint32_t` x count
+ * - `xMomentum` `float`    x count
+ * - `yMomentum` `float`    x count
+ * - `inputs`    `uint32_t` x count, once for each of the `TELEMETRY_INPUTS`
+ *               jet directions (`NONE`, `UP`, `RIGHT`, `DOWN`, `LEFT`)
+ * - `endType`   `uint8_t`  x count, one of `TELEMETRY_CRASH`, `TELEMETRY_LAND`
+ *               or `TELEMETRY_QUIT`
+ *
+ * Each column is padded out to a multiple of 8 bytes, so every column of every
+ * block is suitably aligned when the file is `mmap()`ed. Everything is stored
+ * in the machine's own byte order.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Macros for the log format.
+#define TELEMETRY_MAGIC 0x424c544dU
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_INPUTS 5
+#define TELEMETRY_BATCH 32
+
+// Macros for the type of game end, as written in `endType`. The game uses the
+// same numbers for its own, so they're part of the format too.
+#define TELEMETRY_CRASH 1
+#define TELEMETRY_LAND 2
+#define TELEMETRY_QUIT 3
+
+// Macros for where the log goes. The environment variable wins, if it's set.
+#define TELEMETRY_PATH "moonlander.tlm"
+#define TELEMETRY_PATH_VAR "MOONLANDER_TELEMETRY"
+
+// Macros for working out the sizes of the columns and blocks.
+#define TELEMETRY_COLUMN(count, width) ((((count) * (width)) + 7) & ~(size_t)7)
+#define TELEMETRY_BLOCK_SIZE(count) (sizeof(TELEMETRY_HEADER)                \
+   + TELEMETRY_COLUMN(count, 8) + (4 * TELEMETRY_COLUMN(count, 4))           \
+   + (TELEMETRY_INPUTS * TELEMETRY_COLUMN(count, 4)) + TELEMETRY_COLUMN(count, 1))
+
+// The header at the start of every block.
+typedef struct _telemetry_header_struct {
+   uint32_t magic;
+   uint16_t version, inputs;
+   uint32_t count, reserved;
+}TELEMETRY_HEADER;
+
+// What gets recorded about a single game.
+typedef struct _telemetry_record_struct {
+   uint64_t seed;
+   uint32_t ticks, fuelUsed;
+   float xMomentum, yMomentum;
+   uint32_t inputs[TELEMETRY_INPUTS];
+   uint8_t endType;
+}TELEMETRY_RECORD;
+
+// The telemetry log 'class'. Games are held here, already split into columns,
+// until there's a full batch to write out.
+typedef struct _telemetry_struct {
+   int fd;
+   size_t count;
+   uint64_t seed[TELEMETRY_BATCH];
+   uint32_t ticks[TELEMETRY_BATCH], fuelUsed[TELEMETRY_BATCH];
+   float xMomentum[TELEMETRY_BATCH], yMomentum[TELEMETRY_BATCH];
+   uint32_t inputs[TELEMETRY_INPUTS][TELEMETRY_BATCH];
+   uint8_t endType[TELEMETRY_BATCH];
+   unsigned char block[TELEMETRY_BLOCK_SIZE(TELEMETRY_BATCH)];
+}TELEMETRY;
+
+// Log functions.
+bool openTelemetry(TELEMETRY* telemetry, const char* path);
+bool logGame(TELEMETRY* telemetry, TELEMETRY_RECORD* record);
+bool flushTelemetry(TELEMETRY* telemetry);
+void closeTelemetry(TELEMETRY* telemetry);
+
+#endif /* TELEMETRY_H_ */